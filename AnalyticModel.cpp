@@ -0,0 +1,78 @@
+#include <cmath>       // for exp, log, HUGE_VAL
+#include "AnalyticModel.h"
+
+namespace
+{
+    // load brought by jobs shorter than u mean service times, as a fraction of rho:
+    // the integral of t dF(t) from 0 to u for the unit exponential
+    double shortLoad(double u) { return 1.0 - std::exp(-u) * (1.0 + u); }
+
+    // expectation of f(U) for a unit exponential U, by Simpson's rule. The integrands
+    // below are at most 1 / (1 - rho)^2, so the range covers every term that matters
+    template <class F>
+    double expectation(F f, double rho)
+    {
+        const int steps = 8192; // even, for Simpson's rule
+        double end = 40.0 + 2.0 * std::log(1.0 / (1.0 - rho)),
+               h = end / steps,
+               sum = f(0.0) + std::exp(-end) * f(end);
+
+        for (int i = 1; i < steps; ++i)
+        {
+            double u = i * h;
+            sum += (i % 2 ? 4.0 : 2.0) * std::exp(-u) * f(u);
+        }
+
+        return sum * h / 3.0;
+    }
+}
+
+AnalyticResults analyticResults(int schedule, int lambda, double inverse_mu)
+{
+    AnalyticResults a;
+    double rho = lambda * inverse_mu;
+
+    if (rho >= 1.0) // saturated: the cpu never idles once the queue has built up
+    {
+        a.turnaround_time = a.turnaround_upper = a.processes_in_queue = a.queue_upper = HUGE_VAL;
+        a.cpu_usage = 1.0;
+        a.throughput = 1.0 / inverse_mu;
+        a.stable = false;
+        return a;
+    }
+
+    double fcfs = inverse_mu / (1.0 - rho);
+
+    if (schedule == 2) // SRPT: waiting for the work shorter than the job, then residence slowed by shorter arrivals
+    {
+        a.turnaround_time = inverse_mu * expectation([rho](double u)
+        {
+            double below = 1.0 - rho * shortLoad(u);
+            return rho * shortLoad(u) / (below * below) + 1.0 / below;
+        }, rho);
+    }
+    else if (schedule == 3) // between non-preemptive shortest job first and FCFS
+    {
+        a.turnaround_time = inverse_mu + rho * inverse_mu * expectation([rho](double u)
+        {
+            double below = 1.0 - rho * shortLoad(u);
+            return 1.0 / (below * below);
+        }, rho);
+        a.exact = false;
+    }
+    else a.turnaround_time = fcfs; // FCFS, RR and MLFQ: the number in system is M/M/1's
+
+    a.turnaround_upper = a.exact ? a.turnaround_time : fcfs;
+    a.processes_in_queue = lambda * a.turnaround_time;
+    a.queue_upper = lambda * a.turnaround_upper;
+    a.cpu_usage = rho;
+    a.throughput = lambda;
+
+    return a;
+}
+
+bool agrees(const ConfidenceInterval& simulated, double low, double high, double tolerance)
+{
+    double slack = simulated.half_width + tolerance * high;
+    return simulated.mean + slack >= low && simulated.mean - slack <= high;
+}
@@ -0,0 +1,39 @@
+#ifndef ANALYTIC_MODEL_H
+#define ANALYTIC_MODEL_H
+
+#include "ConfidenceInterval.h"
+
+// Expected metrics of the synthetic workload on one cpu: Poisson arrivals at lambda and
+// exponential service times of mean Ts, an M/M/1 queue with rho = lambda * Ts.
+//
+// FCFS, Round Robin at any quantum and MLFQ never look at service times, and a busy
+// cpu completes work at rate 1/Ts whichever process it runs, so all three have the
+// M/M/1 mean Tq = Ts / (1 - rho) (processor sharing's too). SRTF is the Schrage-Miller
+// integral for SRPT, evaluated numerically. HRRN has no closed form: its Tq is bounded
+// below by non-preemptive shortest job first, optimal among non-preemptive schedulers,
+// and above by FCFS, which HRRN improves on by favouring short jobs. W is the ready
+// queue a departure leaves behind, which departures see as the time average: lambda *
+// Tq by Little's law. From rho = 1 on the queue grows without bound.
+struct AnalyticResults
+{
+    double turnaround_time,    // expected Tq (its lower bound where there is no exact value)
+           turnaround_upper,   // upper bound of Tq, equal to turnaround_time when exact
+           processes_in_queue, // expected W (likewise a lower bound)
+           queue_upper,        // upper bound of W
+           cpu_usage,          // Rho
+           throughput;         // lambda, or 1 / Ts once the cpu saturates
+    bool stable,               // rho < 1: Tq and W are finite
+         exact;                // Tq and W are values rather than bounds (all but HRRN)
+
+    AnalyticResults() : turnaround_time(0), turnaround_upper(0), processes_in_queue(0), queue_upper(0),
+                        cpu_usage(0), throughput(0), stable(true), exact(true) {}
+};
+
+AnalyticResults analyticResults(int schedule, int lambda, double inverse_mu); // scheduler 1-5 on one cpu
+
+// Whether a simulated interval is consistent with the expected range [low, high]. Runs
+// start from an empty system and stop after a fixed number of jobs, so their means are
+// biased low near saturation; tolerance (a fraction of the expected value) allows for it.
+bool agrees(const ConfidenceInterval& simulated, double low, double high, double tolerance);
+
+#endif // ANALYTIC_MODEL_H
@@ -0,0 +1,13 @@
+#ifndef BALANCE_STRATEGY_H
+#define BALANCE_STRATEGY_H
+
+// How a multi-core run spreads processes over the per-core ready queues
+enum BalanceStrategy
+{
+    global_queue,  // arrivals go to an idle core, else the shortest queue; an idle core takes the most urgent waiting process anywhere
+    random_push,   // arrivals go to a uniformly random core; queues are never rebalanced
+    two_choices,   // arrivals go to the less loaded of two random cores; queues are never rebalanced
+    work_stealing  // arrivals go to a random core; a core that runs dry steals from the longest queue
+};
+
+#endif // BALANCE_STRATEGY_H
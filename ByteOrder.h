@@ -0,0 +1,35 @@
+#ifndef BYTE_ORDER_H
+#define BYTE_ORDER_H
+
+#include <cstddef>     // for size_t
+#include <cstring>     // for memcpy
+#include <utility>     // for swap
+
+// The binary files (workload traces, snapshots, event timelines) are little-endian on
+// every host. littleEndian() converts a scalar between host and file order in either
+// direction: nothing to do on a little-endian host (the test folds away at compile
+// time), a byte reversal on a big-endian one.
+namespace ByteOrder
+{
+    inline bool hostLittleEndian()
+    {
+        const unsigned int one = 1;
+        unsigned char first;
+        std::memcpy(&first, &one, 1);
+        return first == 1;
+    }
+
+    template <class T>
+    T littleEndian(T v)
+    {
+        if (hostLittleEndian()) return v;
+
+        unsigned char b[sizeof(T)];
+        std::memcpy(b, &v, sizeof(T));
+        for (std::size_t i = 0; i < sizeof(T) / 2; ++i) std::swap(b[i], b[sizeof(T) - 1 - i]);
+        std::memcpy(&v, b, sizeof(T));
+        return v;
+    }
+}
+
+#endif // BYTE_ORDER_H
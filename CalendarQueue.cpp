@@ -0,0 +1,207 @@
+#include <algorithm>   // for lower_bound, partial_sort
+#include <cmath>       // for floor
+#include "CalendarQueue.h"
+
+namespace
+{
+    const std::size_t min_buckets = 2;   // never shrink below this many buckets
+    const std::size_t width_sample = 25; // events sampled when estimating day width
+}
+
+CalendarQueue::CalendarQueue()
+{
+    buckets.resize(min_buckets);
+    mask = min_buckets - 1;
+    count = 0;
+    current = 0;
+    current_slot = 0;
+    width = 1.0;
+}
+
+unsigned long long CalendarQueue::slotOf(double t) const
+{
+    return static_cast<unsigned long long>(std::floor(t / width));
+}
+
+EventHandle CalendarQueue::push(const Event& e)
+{
+    EventHandle h;
+
+    if (free_handles.empty())
+    {
+        h = static_cast<EventHandle>(live.size());
+        handle_time.push_back(0.0);
+        live.push_back(false);
+    }
+    else
+    {
+        h = free_handles.back();
+        free_handles.pop_back();
+    }
+
+    insert(Entry(e, h));
+
+    if (count > 2 * buckets.size()) resize(2 * buckets.size());
+
+    return h;
+}
+
+const Event& CalendarQueue::top()
+{
+    locate();
+    return buckets[current].back().e;
+}
+
+void CalendarQueue::pop()
+{
+    locate();
+
+    EventHandle h = buckets[current].back().h;
+    buckets[current].pop_back();
+    --count;
+
+    live[h] = false;
+    free_handles.push_back(h);
+
+    if (count < buckets.size() / 2 && buckets.size() > min_buckets) resize(buckets.size() / 2);
+}
+
+bool CalendarQueue::cancel(EventHandle h)
+{
+    if (h >= live.size() || !live[h]) return false; // already fired or cancelled
+
+    erase(h);
+    free_handles.push_back(h);
+
+    if (count < buckets.size() / 2 && buckets.size() > min_buckets) resize(buckets.size() / 2);
+
+    return true;
+}
+
+void CalendarQueue::reschedule(EventHandle h, const Event& e)
+{
+    erase(h);
+    insert(Entry(e, h));
+}
+
+void CalendarQueue::insert(const Entry& x)
+{
+    unsigned long long slot = slotOf(x.e.time);
+    Bucket& b = buckets[slot & mask];
+
+    // ahead of equal times, so it pops after them
+    std::size_t i = b.size();
+    while (i > 0 && b[i - 1].e.time <= x.e.time) --i;
+    b.insert(b.begin() + i, x);
+
+    if (count == 0 || slot < current_slot) // an event earlier than the cursor's day pulls the cursor back
+    {
+        current_slot = slot;
+        current = slot & mask;
+    }
+
+    handle_time[x.h] = x.e.time;
+    live[x.h] = true;
+    ++count;
+}
+
+void CalendarQueue::erase(EventHandle h)
+{
+    Bucket& b = buckets[slotOf(handle_time[h]) & mask];
+
+    for (std::size_t i = 0; i < b.size(); ++i)
+    {
+        if (b[i].h == h)
+        {
+            b.erase(b.begin() + i);
+            break;
+        }
+    }
+
+    live[h] = false;
+    --count;
+}
+
+void CalendarQueue::locate()
+{
+    // walk at most one year of days from the cursor looking for an event due on its day
+    for (std::size_t i = 0; i < buckets.size(); ++i)
+    {
+        const Bucket& b = buckets[current];
+
+        if (!b.empty() && slotOf(b.back().e.time) <= current_slot) return;
+
+        current = (current + 1) & mask;
+        ++current_slot;
+    }
+
+    // nothing due within a year: fall back to a direct search of every bucket's earliest event
+    std::size_t best = 0;
+    bool found = false;
+
+    for (std::size_t i = 0; i < buckets.size(); ++i)
+    {
+        if (buckets[i].empty()) continue;
+
+        if (!found || buckets[i].back().e.time < buckets[best].back().e.time)
+        {
+            best = i;
+            found = true;
+        }
+    }
+
+    current = best;
+    current_slot = slotOf(buckets[best].back().e.time);
+}
+
+void CalendarQueue::resize(std::size_t n)
+{
+    std::vector<Entry> all;
+    all.reserve(count);
+
+    for (std::size_t i = 0; i < buckets.size(); ++i)
+        all.insert(all.end(), buckets[i].rbegin(), buckets[i].rend()); // earliest first keeps equal times in order
+
+    double w = sampleWidth(all);
+    if (w > 0) width = w; // keep the previous width if the sample could not estimate one
+
+    buckets.assign(n, Bucket());
+    mask = n - 1;
+    count = 0;
+
+    for (std::size_t i = 0; i < all.size(); ++i)
+        insert(all[i]);
+}
+
+double CalendarQueue::sampleWidth(const std::vector<Entry>& all) const
+{
+    if (all.size() < 2) return 0.0;
+
+    std::size_t n = std::min(all.size(), width_sample);
+    std::vector<double> times(all.size());
+
+    for (std::size_t i = 0; i < all.size(); ++i) times[i] = all[i].e.time;
+
+    std::partial_sort(times.begin(), times.begin() + n, times.end());
+
+    // average separation of the earliest events, then again ignoring outliers beyond twice that
+    double average = (times[n - 1] - times[0]) / (n - 1), sum = 0.0;
+    std::size_t kept = 0;
+
+    for (std::size_t i = 1; i < n; ++i)
+    {
+        double gap = times[i] - times[i - 1];
+        if (gap <= 2.0 * average) { sum += gap; ++kept; }
+    }
+
+    if (kept == 0 || sum <= 0.0) return 3.0 * average;
+
+    return 3.0 * sum / kept;
+}
+
+void CalendarQueue::pending(std::vector<PendingEvent>& out) const
+{
+    for (std::size_t i = 0; i < buckets.size(); ++i)
+        for (std::size_t j = 0; j < buckets[i].size(); ++j)
+            out.push_back(PendingEvent(buckets[i][j].e, buckets[i][j].h));
+}
@@ -0,0 +1,57 @@
+#ifndef CALENDAR_QUEUE_H
+#define CALENDAR_QUEUE_H
+
+#include <vector>      // for bucket array, bucket contents and handle table
+#include "EventSet.h"
+
+// Future-event set backed by a calendar queue (R. Brown, 1988). Events are hashed by
+// time into an array of buckets ("days" of a repeating "year"); the queue resizes
+// itself and re-estimates the day width as it grows and shrinks, giving amortized
+// O(1) push and pop when event times are reasonably spread. Cancel and reschedule
+// find the event through the bucket its handle's time hashes to.
+class CalendarQueue : public EventSet
+{
+public:
+    // Constructor
+    CalendarQueue();
+
+    EventHandle push(const Event& e);
+    const Event& top();
+    void pop();
+    bool cancel(EventHandle h);
+    void reschedule(EventHandle h, const Event& e);
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+    void pending(std::vector<PendingEvent>& out) const;
+
+private:
+    struct Entry
+    {
+        Event e;
+        EventHandle h; // handle of this event
+
+        Entry(const Event& new_e, EventHandle new_h) : e(new_e), h(new_h) {}
+    };
+
+    typedef std::vector<Entry> Bucket; // kept sorted latest-first so the earliest event sits at back()
+
+    unsigned long long slotOf(double t) const; // absolute day number of time t
+    void insert(const Entry& x);               // file an entry in its bucket and keep the cursor ahead of it
+    void erase(EventHandle h);                 // unfile the entry for a pending handle
+    void locate();                             // move cursor to the bucket holding the earliest event
+    void resize(std::size_t n);                // rehash into n buckets with a freshly sampled width
+    double sampleWidth(const std::vector<Entry>& all) const; // estimate day width from the earliest events
+
+    std::vector<Bucket> buckets;
+    std::vector<double> handle_time;       // time of the pending event for each handle
+    std::vector<bool> live;                // whether each handle names a pending event
+    std::vector<EventHandle> free_handles; // handles available for reuse
+
+    std::size_t count,                 // pending events
+                mask,                  // buckets.size() - 1 (bucket count is a power of two)
+                current;               // cursor: bucket being drained
+    unsigned long long current_slot;   // cursor: day number being drained
+    double width;                      // length of a day
+};
+
+#endif // CALENDAR_QUEUE_H
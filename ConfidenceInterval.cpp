@@ -0,0 +1,44 @@
+#include <cmath>       // for sqrt
+#include "ConfidenceInterval.h"
+
+double studentT95(int degrees_of_freedom)
+{
+    // two-sided 95% critical values for 1-30 degrees of freedom
+    static const double table[] =
+    {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+
+    if (degrees_of_freedom < 1) return 0.0;
+    if (degrees_of_freedom <= 30) return table[degrees_of_freedom - 1];
+
+    // Cornish-Fisher style expansion around the normal quantile, accurate to ~1e-3 beyond 30
+    double z = 1.959964,
+           v = degrees_of_freedom;
+
+    return z + (z * z * z + z) / (4.0 * v) + (5.0 * z * z * z * z * z + 16.0 * z * z * z + 3.0 * z) / (96.0 * v * v);
+}
+
+ConfidenceInterval confidenceInterval(const std::vector<double>& samples)
+{
+    ConfidenceInterval ci;
+    std::size_t n = samples.size();
+
+    if (n == 0) return ci;
+
+    double sum = 0.0;
+    for (std::size_t i = 0; i < n; ++i) sum += samples[i];
+    ci.mean = sum / n;
+
+    if (n < 2) return ci;
+
+    double squares = 0.0;
+    for (std::size_t i = 0; i < n; ++i) squares += (samples[i] - ci.mean) * (samples[i] - ci.mean);
+
+    double variance = squares / (n - 1); // unbiased sample variance
+    ci.half_width = studentT95(static_cast<int>(n - 1)) * std::sqrt(variance / n);
+
+    return ci;
+}
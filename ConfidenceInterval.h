@@ -0,0 +1,18 @@
+#ifndef CONFIDENCE_INTERVAL_H
+#define CONFIDENCE_INTERVAL_H
+
+#include <vector>      // for samples
+
+// Sample mean with the half-width of its two-sided 95% Student-t confidence interval
+struct ConfidenceInterval
+{
+    double mean,
+           half_width; // interval is mean +/- half_width (0 with fewer than two samples)
+
+    ConfidenceInterval() : mean(0), half_width(0) {}
+};
+
+double studentT95(int degrees_of_freedom);                        // two-sided 95% critical value
+ConfidenceInterval confidenceInterval(const std::vector<double>&); // interval for the mean of independent samples
+
+#endif // CONFIDENCE_INTERVAL_H
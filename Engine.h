@@ -0,0 +1,76 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include "SimulationCore.h"
+
+// Event loop specialized for one scheduling discipline. Policy must provide:
+//
+//   typedef ... ReadyQueue;                                 // container of waiting processes
+//   void onArrival(SimulationCore& sim, ProcessId p);       // p has just arrived
+//   void onDeparture(SimulationCore& sim, ProcessId p);     // p's departure event fired
+//   void onTimeSlice(SimulationCore& sim, ProcessId p);     // p's time slice expired
+//   std::size_t waiting() const;                            // processes in the ready queue
+//   bool idle() const;                                      // no process on the cpu
+//   static const unsigned int snapshot_tag;                 // distinct per discipline
+//   void save(SnapshotWriter& w, SnapshotNumbering& numbering) const; // queue and cpu state
+//   bool restore(SnapshotReader& r, const RestoreContext& context);   // the reverse
+//
+// MultiCoreEngine additionally needs:
+//
+//   ProcessId steal(SimulationCore& sim);                   // remove the process that would run next (queue not empty)
+//   double nextPriority(SimulationCore& sim);               // rank of that process across cores, lower runs sooner
+//
+// A policy holds only its own ready queue and cpu state, reading and writing process
+// fields through sim.processTable(), and the handlers are resolved
+// at compile time, so the loop below dispatches on the event type alone. New policies
+// are plugged in by instantiating Engine<MyPolicy>; nothing else needs to change.
+template <class Policy>
+class Engine : public SimulationCore
+{
+public:
+    // Constructor
+    Engine(const Policy& p, JobSource* source, EventSetType e_s = indexed_heap, unsigned long jobs = 10000) :
+        SimulationCore(source, e_s, jobs), policy(p) {}
+
+    SimulationResults run()
+    {
+        while (!finished())
+        {
+            Event e = nextEvent();
+
+            switch(e.type)
+            {
+                case arrival:
+                    trace(trace_arrival, e.p);
+                    policy.onArrival(*this, e.p);
+                    scheduleArrival(); // schedule the next arrival to simulate continuous arrival of processes
+                    break;
+                case departure:
+                    trace(trace_departure, e.p);
+                    policy.onDeparture(*this, e.p);
+                    break;
+                case time_slice:
+                    trace(trace_time_slice, e.p);
+                    policy.onTimeSlice(*this, e.p);
+                    break;
+            }
+
+            observeLevels(policy.waiting(), policy.idle() ? 0 : 1);
+        }
+
+        return results();
+    }
+
+    const Policy& discipline() const { return policy; }
+
+protected:
+    unsigned int policyTag() const { return Policy::snapshot_tag; }
+    unsigned int cpuCount() const { return 1; }
+    void savePolicy(SnapshotWriter& w, SnapshotNumbering& numbering) const { policy.save(w, numbering); }
+    bool restorePolicy(SnapshotReader& r, const RestoreContext& context) { return policy.restore(r, context); }
+
+private:
+    Policy policy;
+};
+
+#endif // ENGINE_H
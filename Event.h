@@ -1,16 +1,19 @@
-#ifndef EVENT_H
-#define EVENT_H
-
-#include "EventType.h"
-#include "Process.h"
-
-struct Event
-{
-    double time; // use for time of arrival, departure, etc.
-    EventType type; // use to specify the type of event (arrival, departure, time slice)
-    Process* p; // pointer to the corresponding process
-
-    Event(double t, EventType e, Process* new_p) : time(t), type(e), p(new_p) {}
-};
-
-#endif // EVENT_H
\ No newline at end of file
+#ifndef EVENT_H
+#define EVENT_H
+
+#include "EventType.h"
+#include "Process.h"
+
+// 16 bytes: the time, then the process id and type packed into the second word
+struct Event
+{
+    double time; // use for time of arrival, departure, etc.
+    ProcessId p; // the corresponding process
+    EventType type; // use to specify the type of event (arrival, departure, time slice)
+
+    Event(double t, EventType e, ProcessId new_p) : time(t), p(new_p), type(e) {}
+};
+
+static_assert(sizeof(Event) <= 16, "Event should stay within two words");
+
+#endif // EVENT_H
@@ -0,0 +1,13 @@
+#include "EventSet.h"
+#include "IndexedHeapEventSet.h"
+#include "CalendarQueue.h"
+
+EventSet* EventSet::create(EventSetType type)
+{
+    switch(type)
+    {
+        case calendar_queue: return new CalendarQueue();
+        case indexed_heap:
+        default: return new IndexedHeapEventSet();
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef EVENT_SET_H
+#define EVENT_SET_H
+
+#include <cstddef>     // for size_t
+#include <vector>      // for listing pending events
+#include "Event.h"
+
+// Backends available for the future-event set
+enum EventSetType
+{
+    indexed_heap, calendar_queue
+};
+
+// Identifies a pending event so it can be cancelled or rescheduled. A handle is valid
+// from push() until its event is popped or cancelled, after which it may be reused.
+typedef unsigned int EventHandle;
+
+// A pending event together with its handle
+struct PendingEvent
+{
+    Event e;
+    EventHandle h;
+
+    PendingEvent(const Event& new_e, EventHandle new_h) : e(new_e), h(new_h) {}
+};
+
+// Interface of the future-event set: a priority queue of events ordered by time,
+// earliest event at the front
+class EventSet
+{
+public:
+    virtual ~EventSet() {}
+
+    virtual EventHandle push(const Event& e) = 0;              // insert a pending event
+    virtual const Event& top() = 0;                             // earliest pending event (set must not be empty)
+    virtual void pop() = 0;                                     // remove the earliest pending event
+    virtual bool cancel(EventHandle h) = 0;                     // remove a pending event (false if it is no longer pending)
+    virtual void reschedule(EventHandle h, const Event& e) = 0; // replace a pending event, keeping its handle
+    virtual bool empty() const = 0;
+    virtual std::size_t size() const = 0;
+    virtual void pending(std::vector<PendingEvent>& out) const = 0; // append every pending event, in no particular order
+
+    static EventSet* create(EventSetType type); // construct a backend; caller owns the result
+};
+
+#endif // EVENT_SET_H
@@ -0,0 +1,242 @@
+#include <chrono>      // for writer back-off
+#include <cstring>     // for memcmp
+#include <limits>      // for max_digits10
+#include "EventTrace.h"
+#include "ByteOrder.h"
+
+namespace
+{
+    const char magic[8] = { 'C', 'P', 'U', 'E', 'V', 'E', 'N', 'T' };
+    const uint32_t version = 1;
+    const std::size_t header_bytes = 24;
+
+    // a record's multi-byte fields between host and file order
+    TraceRecord littleEndian(TraceRecord r)
+    {
+        r.time = ByteOrder::littleEndian(r.time);
+        r.process = ByteOrder::littleEndian(r.process);
+        r.queue_depth = ByteOrder::littleEndian(r.queue_depth);
+        r.cpu = ByteOrder::littleEndian(r.cpu);
+        return r;
+    }
+}
+
+EventTracer::EventTracer() : ring(capacity), head(0), tail(0), tail_seen(0), waits(0), stopping(false) {}
+
+EventTracer::~EventTracer()
+{
+    if (writer.joinable()) close();
+}
+
+bool EventTracer::open(const char* path)
+{
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        message = std::string("cannot create ") + path;
+        return false;
+    }
+
+    uint32_t file_version = ByteOrder::littleEndian(version),
+             record = ByteOrder::littleEndian<uint32_t>(sizeof(TraceRecord));
+    uint64_t count = 0; // patched on close
+
+    out.write(magic, sizeof(magic));
+    out.write(reinterpret_cast<const char*>(&file_version), sizeof(file_version));
+    out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+
+    stopping.store(false);
+    writer = std::thread(&EventTracer::drain, this);
+
+    return true;
+}
+
+bool EventTracer::close()
+{
+    if (!writer.joinable()) return false;
+
+    stopping.store(true, std::memory_order_release);
+    writer.join();
+
+    uint64_t count = ByteOrder::littleEndian<uint64_t>(head.load());
+    out.seekp(16);
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    out.close();
+
+    if (out.fail())
+    {
+        message = "write failed";
+        return false;
+    }
+
+    return true;
+}
+
+void EventTracer::waitForSpace(std::size_t h)
+{
+    tail_seen = tail.load(std::memory_order_acquire);
+    if (h - tail_seen < capacity) return;
+
+    ++waits;
+    do
+    {
+        std::this_thread::yield();
+        tail_seen = tail.load(std::memory_order_acquire);
+    }
+    while (h - tail_seen == capacity);
+}
+
+void EventTracer::drain()
+{
+    std::size_t t = tail.load(std::memory_order_relaxed);
+    std::vector<TraceRecord> swapped; // records in file order, on big-endian hosts only
+
+    for (;;)
+    {
+        bool last = stopping.load(std::memory_order_acquire); // read before head, so nothing published before stop is missed
+        std::size_t h = head.load(std::memory_order_acquire);
+
+        if (h == t)
+        {
+            if (last) break;
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            continue;
+        }
+
+        while (t != h) // write the published records, at most two contiguous runs of the ring
+        {
+            std::size_t first = t & (capacity - 1),
+                        run = h - t < capacity - first ? h - t : capacity - first;
+
+            const TraceRecord* records = &ring[first];
+            if (!ByteOrder::hostLittleEndian())
+            {
+                swapped.resize(run);
+                for (std::size_t i = 0; i < run; ++i) swapped[i] = littleEndian(ring[first + i]);
+                records = &swapped[0];
+            }
+
+            out.write(reinterpret_cast<const char*>(records), run * sizeof(TraceRecord));
+            t += run;
+            tail.store(t, std::memory_order_release);
+        }
+    }
+}
+
+bool exportChromeTrace(const char* timeline_path, const char* json_path, unsigned long long& records, std::string& error)
+{
+    std::ifstream in(timeline_path, std::ios::binary);
+    if (!in)
+    {
+        error = std::string("cannot open ") + timeline_path;
+        return false;
+    }
+
+    char header[header_bytes];
+    uint32_t file_version, record;
+    uint64_t count;
+
+    if (!in.read(header, header_bytes) || memcmp(header, magic, sizeof(magic)) != 0)
+    {
+        error = std::string(timeline_path) + " is not an event timeline";
+        return false;
+    }
+
+    memcpy(&file_version, header + 8, sizeof(file_version));
+    memcpy(&record, header + 12, sizeof(record));
+    memcpy(&count, header + 16, sizeof(count));
+    file_version = ByteOrder::littleEndian(file_version);
+    record = ByteOrder::littleEndian(record);
+    count = ByteOrder::littleEndian(count);
+
+    if (file_version != version || record != sizeof(TraceRecord))
+    {
+        error = std::string(timeline_path) + ": unsupported timeline version " + std::to_string(file_version);
+        return false;
+    }
+
+    std::ofstream out(json_path);
+    if (!out)
+    {
+        error = std::string("cannot create ") + json_path;
+        return false;
+    }
+
+    out.precision(std::numeric_limits<double>::max_digits10);
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n"
+        << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 0, \"args\": {\"name\": \"CPU scheduler\"}}";
+
+    std::vector<int64_t> running; // job on each cpu's open slice, -1 if none
+    std::vector<TraceRecord> block(4096);
+    uint32_t last_depth = 0xFFFFFFFF;
+    records = 0;
+
+    while (records < count)
+    {
+        std::size_t want = count - records < block.size() ? static_cast<std::size_t>(count - records) : block.size();
+        in.read(reinterpret_cast<char*>(&block[0]), want * sizeof(TraceRecord));
+        std::size_t got = static_cast<std::size_t>(in.gcount()) / sizeof(TraceRecord);
+        if (got == 0) break;
+
+        for (std::size_t i = 0; i < got; ++i)
+        {
+            const TraceRecord r = littleEndian(block[i]);
+            double ts = r.time * 1e6;
+
+            if (r.cpu >= running.size())
+            {
+                for (std::size_t c = running.size(); c <= r.cpu; ++c)
+                    out << ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": " << c
+                        << ", \"args\": {\"name\": \"cpu " << c << "\"}}";
+                running.resize(r.cpu + 1, -1);
+            }
+
+            switch (r.kind)
+            {
+                case trace_dispatch:
+                    if (running[r.cpu] >= 0) out << ",\n{\"ph\": \"E\", \"pid\": 0, \"tid\": " << r.cpu << ", \"ts\": " << ts << "}";
+                    out << ",\n{\"name\": \"job " << r.process << "\", \"ph\": \"B\", \"pid\": 0, \"tid\": " << r.cpu
+                        << ", \"ts\": " << ts << "}";
+                    running[r.cpu] = r.process;
+                    break;
+                case trace_preempt:
+                case trace_time_slice:
+                case trace_departure:
+                    if (running[r.cpu] == static_cast<int64_t>(r.process))
+                    {
+                        out << ",\n{\"ph\": \"E\", \"pid\": 0, \"tid\": " << r.cpu << ", \"ts\": " << ts << "}";
+                        running[r.cpu] = -1;
+                    }
+                    if (r.kind == trace_departure)
+                        out << ",\n{\"name\": \"departure\", \"ph\": \"i\", \"s\": \"t\", \"pid\": 0, \"tid\": " << r.cpu
+                            << ", \"ts\": " << ts << ", \"args\": {\"job\": " << r.process << "}}";
+                    break;
+                case trace_arrival:
+                case trace_migrate:
+                    out << ",\n{\"name\": \"" << (r.kind == trace_arrival ? "arrival" : "migrate") << "\", \"ph\": \"i\", \"s\": \"t\", \"pid\": 0, \"tid\": "
+                        << r.cpu << ", \"ts\": " << ts << ", \"args\": {\"job\": " << r.process << "}}";
+                    break;
+            }
+
+            if (r.queue_depth != last_depth)
+            {
+                out << ",\n{\"name\": \"ready queue\", \"ph\": \"C\", \"pid\": 0, \"ts\": " << ts
+                    << ", \"args\": {\"waiting\": " << r.queue_depth << "}}";
+                last_depth = r.queue_depth;
+            }
+        }
+
+        records += got;
+    }
+
+    out << "\n]}\n";
+
+    if (records != count)
+    {
+        error = std::string(timeline_path) + " is truncated";
+        return false;
+    }
+
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,99 @@
+#ifndef EVENT_TRACE_H
+#define EVENT_TRACE_H
+
+#include <atomic>      // for ring buffer indices
+#include <cstddef>     // for size_t
+#include <fstream>     // for the trace file
+#include <string>      // for error messages
+#include <thread>      // for the background writer
+#include <vector>      // for the ring storage
+#include <stdint.h>    // for fixed-width record fields
+
+// What happened to a process
+enum TraceKind
+{
+    trace_arrival,    // entered the system
+    trace_dispatch,   // got a cpu
+    trace_preempt,    // lost its cpu to another process
+    trace_time_slice, // its quantum expired
+    trace_departure,  // finished
+    trace_migrate     // moved to another cpu's ready queue
+};
+
+// One timeline entry. Every record is 24 bytes; queue_depth is the number of processes
+// waiting in ready queues (all cpus) when the event fired.
+struct TraceRecord
+{
+    double time;
+    uint32_t process,     // job number in arrival order (wraps at 2^32)
+             queue_depth;
+    uint16_t cpu;
+    uint8_t kind;         // TraceKind
+    uint8_t reserved[5];
+};
+
+// Event timeline file, little-endian on every host (see ByteOrder.h): the 8 byte magic
+// "CPUEVENT", a uint32 version, a uint32 record size and a uint64 record count, then the
+// records.
+//
+// The simulation thread appends records to a single-producer/single-consumer ring with
+// two atomic indices and no locks; a background thread drains it to the file. If the
+// writer falls a whole ring behind, the simulation waits for it rather than drop events.
+class EventTracer
+{
+public:
+    // Constructor
+    EventTracer();
+    // Destructor
+    ~EventTracer();
+
+    bool open(const char* path); // create the file and start the writer
+    bool close();                // flush every record, stop the writer and finish the header
+
+    void record(double time, TraceKind kind, unsigned int process, unsigned int cpu, std::size_t queue_depth)
+    {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        if (h - tail_seen == capacity) waitForSpace(h);
+
+        TraceRecord& r = ring[h & (capacity - 1)];
+        r.time = time;
+        r.process = process;
+        r.queue_depth = static_cast<uint32_t>(queue_depth);
+        r.cpu = static_cast<uint16_t>(cpu);
+        r.kind = static_cast<uint8_t>(kind);
+
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    unsigned long long records() const { return head.load(std::memory_order_relaxed); }
+    unsigned long long stalls() const { return waits; } // times the ring was full
+    const std::string& error() const { return message; }
+
+private:
+    EventTracer(const EventTracer&);            // non-copyable: owns a thread and a file
+    EventTracer& operator=(const EventTracer&);
+
+    void waitForSpace(std::size_t h);
+    void drain(); // writer thread body
+
+    static const std::size_t capacity = 1 << 16; // records in the ring (power of two)
+
+    std::vector<TraceRecord> ring;
+    std::atomic<std::size_t> head;  // next slot the simulation fills
+    char pad[64];                   // keep the two indices on separate cache lines
+    std::atomic<std::size_t> tail;  // next slot the writer drains
+    std::size_t tail_seen;          // producer's last view of tail
+    unsigned long long waits;
+    std::atomic<bool> stopping;
+    std::thread writer;
+    std::ofstream out;
+    std::string message;
+};
+
+// Convert an event timeline to Chrome trace / Perfetto JSON: one track per cpu with a
+// slice for every stretch a process ran, instant events for arrivals, departures and
+// migrations, and a counter track for the ready-queue depth. Times are written in
+// microseconds, taking one simulated time unit as one second.
+bool exportChromeTrace(const char* timeline_path, const char* json_path, unsigned long long& records, std::string& error);
+
+#endif // EVENT_TRACE_H
@@ -1,9 +1,9 @@
-#ifndef EVENT_TYPE_H
-#define EVENT_TYPE_H
-
-enum EventType
-{
-    arrival, departure, time_slice
-};
-
+#ifndef EVENT_TYPE_H
+#define EVENT_TYPE_H
+
+enum EventType
+{
+    arrival, departure, time_slice
+};
+
 #endif // EVENT_TYPE_H
\ No newline at end of file
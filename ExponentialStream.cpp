@@ -0,0 +1,184 @@
+#include <cstring>     // for memcpy (bit casts)
+#include "ExponentialStream.h"
+
+namespace
+{
+    unsigned long long rotl(unsigned long long x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    unsigned long long splitmix64(unsigned long long& x)
+    {
+        unsigned long long z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Natural logarithm of x in (0, 1), written without branches or calls so the loop that
+    // applies it vectorizes. x = m * 2^e with m in [sqrt(1/2), sqrt(2)), then
+    // log(m) = 2 atanh(z) with z = (m - 1) / (m + 1), |z| < 0.172, summed to z^23.
+    inline double logUnit(double x)
+    {
+        const unsigned long long sqrt2_fraction = 0x0006A09E667F3BCDULL; // fraction field of sqrt(2)
+        const double ln2_hi = 6.93147180369123816490e-01,  // ln 2 split so e * ln2_hi is exact
+                     ln2_lo = 1.90821492927058770002e-10,
+                     two52 = 4503599627370496.0;           // 2^52, for integer-to-double without a conversion instruction
+
+        unsigned long long bits;
+        std::memcpy(&bits, &x, sizeof bits);
+
+        // mantissa as a double in [1, 2); if above sqrt(2), halve it and bump the exponent.
+        // The test is a carry out of the fraction field (fraction + (2^52 - 1 - fraction of
+        // sqrt 2)), so the whole adjustment is integer arithmetic with no branch or compare.
+        unsigned long long fraction = bits & 0x000FFFFFFFFFFFFFULL,
+                           high = (fraction + (0x000FFFFFFFFFFFFFULL - sqrt2_fraction)) >> 52,
+                           mantissa_bits = (fraction | 0x3FF0000000000000ULL) - (high << 52);
+        double m;
+        std::memcpy(&m, &mantissa_bits, sizeof m);
+
+        // biased exponent as a double: place it in the mantissa of 2^52 and subtract
+        unsigned long long exponent_bits = ((bits >> 52) + high) | 0x4330000000000000ULL;
+        double e;
+        std::memcpy(&e, &exponent_bits, sizeof e);
+        e -= two52 + 1023.0;
+
+        double z = (m - 1.0) / (m + 1.0),
+               z2 = z * z,
+               series = 1.0 + z2 * (1.0/3 + z2 * (1.0/5 + z2 * (1.0/7 + z2 * (1.0/9 + z2 * (1.0/11
+                      + z2 * (1.0/13 + z2 * (1.0/15 + z2 * (1.0/17 + z2 * (1.0/19 + z2 * (1.0/21
+                      + z2 * (1.0/23)))))))))));
+
+        return e * ln2_hi + (e * ln2_lo + 2.0 * z * series);
+    }
+}
+
+Xoshiro256::Xoshiro256(unsigned long long seed, unsigned long long stream)
+{
+    unsigned long long x = seed ^ (stream * 0xD1B54A32D192ED03ULL); // distinct streams start from distinct states
+
+    for (int i = 0; i < 4; ++i) s[i] = splitmix64(x);
+}
+
+unsigned long long Xoshiro256::next()
+{
+    unsigned long long result = rotl(s[1] * 5, 7) * 9,
+                       t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+
+    return result;
+}
+
+void Xoshiro256::save(SnapshotWriter& w) const
+{
+    for (int i = 0; i < 4; ++i) w.put(s[i]);
+}
+
+bool Xoshiro256::restore(SnapshotReader& r)
+{
+    for (int i = 0; i < 4; ++i) r.get(s[i]);
+    return r.good();
+}
+
+ExponentialStream::ExponentialStream(double m, unsigned long long seed, unsigned long long stream, bool antithetic) :
+    generator(seed, stream), block_start(generator)
+{
+    mean = m;
+    cursor = block; // first next() fills the buffer
+    flip = antithetic ? ~0ULL : 0;
+}
+
+void ExponentialStream::refill()
+{
+    unsigned long long raw[block];
+
+    block_start = generator;
+    for (std::size_t i = 0; i < block; ++i) raw[i] = generator.next();
+
+    for (std::size_t i = 0; i < block; ++i)
+    {
+        // top 52 bits as the mantissa of a double in [1, 2), shifted down by 1 - 2^-53:
+        // uniform strictly inside (0, 1), so no draw is ever 0, and symmetric about 1/2,
+        // so complementing the bits gives exactly 1 - U
+        unsigned long long unit_bits = ((raw[i] ^ flip) >> 12) | 0x3FF0000000000000ULL;
+        double u;
+        std::memcpy(&u, &unit_bits, sizeof u);
+        u -= 1.0 - 1.0 / 9007199254740992.0;
+
+        buffer[i] = -mean * logUnit(u);
+    }
+
+    cursor = 0;
+}
+
+void ExponentialStream::save(SnapshotWriter& w) const
+{
+    w.put(static_cast<unsigned long long>(cursor));
+    if (cursor == block) generator.save(w); // nothing buffered: the next refill starts from the live state
+    else block_start.save(w);
+}
+
+bool ExponentialStream::restore(SnapshotReader& r)
+{
+    unsigned long long position;
+    if (!r.get(position) || position > block || !generator.restore(r)) return false;
+
+    if (position < block) refill(); // redraw the block the saved stream was reading from
+    cursor = static_cast<std::size_t>(position);
+
+    return true;
+}
+
+ExponentialBatch::ExponentialBatch()
+{
+    for (std::size_t i = 0; i < streams; ++i) setStream(i, 1.0, 1, 0);
+}
+
+void ExponentialBatch::setStream(std::size_t i, double m, unsigned long long seed, unsigned long long stream, bool antithetic)
+{
+    unsigned long long x = seed ^ (stream * 0xD1B54A32D192ED03ULL); // as Xoshiro256's constructor
+
+    s0[i] = splitmix64(x);
+    s1[i] = splitmix64(x);
+    s2[i] = splitmix64(x);
+    s3[i] = splitmix64(x);
+    mean[i] = m;
+    flip[i] = antithetic ? ~0ULL : 0;
+}
+
+VECTOR_CLONES void ExponentialBatch::refill()
+{
+    for (std::size_t j = 0; j < block; ++j)
+    {
+        for (std::size_t i = 0; i < streams; ++i)
+        {
+            // Xoshiro256::next, with the multiplications by 5 and 9 as shifts and adds
+            unsigned long long five = (s1[i] << 2) + s1[i],
+                               rotated = rotl(five, 7),
+                               raw = (rotated << 3) + rotated,
+                               t = s1[i] << 17;
+
+            s2[i] ^= s0[i];
+            s3[i] ^= s1[i];
+            s1[i] ^= s2[i];
+            s0[i] ^= s3[i];
+            s2[i] ^= t;
+            s3[i] = rotl(s3[i], 45);
+
+            // then ExponentialStream::refill's conversion
+            unsigned long long unit_bits = ((raw ^ flip[i]) >> 12) | 0x3FF0000000000000ULL;
+            double u;
+            std::memcpy(&u, &unit_bits, sizeof u);
+            u -= 1.0 - 1.0 / 9007199254740992.0;
+
+            values[j][i] = -mean[i] * logUnit(u);
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef EXPONENTIAL_STREAM_H
+#define EXPONENTIAL_STREAM_H
+
+#include <cstddef>     // for size_t
+#include "Snapshot.h"
+
+// Loops that run across many independent streams or lanes are compiled for AVX-512 and
+// AVX2 as well as the baseline instruction set; the loader picks the widest the cpu
+// has. AVX-512 brings fused multiply-adds, so contraction is turned off to keep every
+// clone's results identical to the baseline build's.
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#define VECTOR_CLONES __attribute__((target_clones("avx512f", "avx2", "default"), optimize("fp-contract=off")))
+#else
+#define VECTOR_CLONES
+#endif
+
+// xoshiro256** (Blackman & Vigna): fast 64-bit generator with 256 bits of state
+class Xoshiro256
+{
+public:
+    // Constructor: expand a seed and a stream number into a full state with splitmix64
+    Xoshiro256(unsigned long long seed, unsigned long long stream);
+
+    unsigned long long next();
+
+    void save(SnapshotWriter& w) const;
+    bool restore(SnapshotReader& r);
+
+private:
+    unsigned long long s[4];
+};
+
+// Buffered source of independent exponential variates. Draws are produced a block at a
+// time: the generator fills the block with raw bits, then a branch-free loop converts
+// them to uniforms and applies a polynomial logarithm, which the compiler vectorizes.
+// An antithetic stream complements the raw bits, so each of its uniforms is exactly
+// 1 - U for the U the plain stream of the same seed draws.
+class ExponentialStream
+{
+public:
+    // Constructor
+    ExponentialStream(double mean, unsigned long long seed, unsigned long long stream, bool antithetic = false);
+
+    double next() // next exponential variate with the stream's mean
+    {
+        if (cursor == block) refill();
+        return buffer[cursor++];
+    }
+
+    static const std::size_t block = 256; // variates produced per refill
+
+    // the generator state the current block was drawn from plus the read position: the
+    // block itself is regenerated on restore rather than stored
+    void save(SnapshotWriter& w) const;
+    bool restore(SnapshotReader& r);
+
+private:
+    void refill();
+
+    Xoshiro256 generator,
+               block_start;    // generator state before the current block was drawn
+    double mean,           // mean of the variates (1/lambda or Ts)
+           buffer[block];  // pending variates
+    std::size_t cursor;    // next unread entry of buffer
+    unsigned long long flip; // xor applied to the raw bits: all ones for an antithetic stream
+};
+
+// Several exponential streams drawn side by side, with the generators' states laid out
+// stream by stream so one refill advances all of them in vector registers. Stream i
+// yields exactly the variates of an ExponentialStream with the same mean, seed and
+// stream number.
+class ExponentialBatch
+{
+public:
+    static const std::size_t streams = 16; // generated together
+    static const std::size_t block = 64;   // variates per stream and refill
+
+    // Constructor: every stream starts as stream 0 of seed 1 with mean 1
+    ExponentialBatch();
+
+    void setStream(std::size_t i, double mean, unsigned long long seed, unsigned long long stream, bool antithetic = false);
+    void refill();                                               // draw the next block of every stream
+    const double* row(std::size_t j) const { return values[j]; } // j-th variate of the block, one per stream
+
+private:
+    unsigned long long s0[streams], // xoshiro256** state words of each stream
+                       s1[streams],
+                       s2[streams],
+                       s3[streams];
+    unsigned long long flip[streams];
+    double mean[streams],
+           values[block][streams];
+};
+
+#endif // EXPONENTIAL_STREAM_H
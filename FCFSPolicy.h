@@ -0,0 +1,100 @@
+#ifndef FCFS_POLICY_H
+#define FCFS_POLICY_H
+
+#include <queue>       // for stl queue data structures
+#include "SimulationCore.h"
+
+// First Come First Serve: non-preemptive, processes run in arrival order
+struct FCFSPolicy
+{
+    typedef std::queue<ProcessId> ReadyQueue;
+
+    ReadyQueue ready_q;
+    ProcessId on_cpu;          // id of process on cpu
+    bool cpu_idle;             // use to determine whether cpu is in use
+
+    FCFSPolicy() : on_cpu(no_process), cpu_idle(true) {}
+
+    void onArrival(SimulationCore& sim, ProcessId p)
+    {
+        if (cpu_idle)                     // FCFS, idle cpu means no process is in ready queue
+        {
+            ProcessTable& table = sim.processTable();
+
+            on_cpu = p;                   // assign process to cpu
+            cpu_idle = false;             // cpu is no longer idle
+            sim.trace(trace_dispatch, p);
+
+            table.completion_time[p] = sim.now() + table.service_time[p]; // runs to completion from now
+            sim.scheduleDeparture(table.completion_time[p], on_cpu);
+
+            sim.addCpuUsage(table.service_time[p]); // FCFS adds to CPU usage amount of time from when a process begins executing and completion
+        }
+        else ready_q.push(p);            // cpu is not idle, put process in ready queue
+    }
+
+    void onDeparture(SimulationCore& sim, ProcessId p)
+    {
+        ProcessTable& table = sim.processTable();
+
+        if (ready_q.empty()) cpu_idle = true; // p's service was charged when it started
+        else
+        {
+            sim.sampleQueue(ready_q.size()); // count the number of processes waiting in ready queue at this process's departure
+            on_cpu = ready_q.front();
+            sim.trace(trace_dispatch, on_cpu);
+            sim.addCpuUsage(table.service_time[on_cpu]); // if cpu was not idle, replace process with next process in ready queue, continue service
+            table.completion_time[on_cpu] = sim.now() + table.service_time[on_cpu]; // it waited, so it completes later than arrival + service
+            sim.scheduleDeparture(table.completion_time[on_cpu], on_cpu);
+            ready_q.pop(); // remove first process from ready queue representing process has completed execution
+        }
+
+        sim.complete(p); // p was on cpu: it is the only process with a departure pending
+    }
+
+    void onTimeSlice(SimulationCore&, ProcessId) {} // FCFS never slices
+
+    std::size_t waiting() const { return ready_q.size(); }
+    bool idle() const { return cpu_idle; }
+
+    // hand the next waiting process to another core (oldest first)
+    ProcessId steal(SimulationCore&)
+    {
+        ProcessId p = ready_q.front();
+        ready_q.pop();
+        return p;
+    }
+
+    double nextPriority(SimulationCore& sim) { return sim.processTable().arrival_time[ready_q.front()]; } // lower runs sooner
+
+    static const unsigned int snapshot_tag = 1;
+
+    // snapshot: cpu state, then the queue front to back
+    void save(SnapshotWriter& w, SnapshotNumbering& numbering) const
+    {
+        ReadyQueue in_order(ready_q); // a copy to walk the queue
+
+        w.put(static_cast<unsigned char>(cpu_idle));
+        w.put(numbering(cpu_idle ? no_process : on_cpu));
+        w.put(static_cast<unsigned int>(in_order.size()));
+        for (; !in_order.empty(); in_order.pop()) w.put(numbering(in_order.front()));
+    }
+
+    bool restore(SnapshotReader& r, const RestoreContext& context)
+    {
+        unsigned char idle = 1;
+        unsigned int n = 0;
+
+        r.get(idle);
+        cpu_idle = idle != 0;
+        on_cpu = context.process(r);
+
+        ready_q = ReadyQueue();
+        r.get(n);
+        for (unsigned int i = 0; i < n && r.good(); ++i) ready_q.push(context.required(r));
+
+        return r.good() && (cpu_idle || on_cpu != no_process);
+    }
+};
+
+#endif // FCFS_POLICY_H
@@ -0,0 +1,111 @@
+#ifndef HRRN_POLICY_H
+#define HRRN_POLICY_H
+
+#include <vector>      // for snapshot order
+#include "SimulationCore.h"
+#include "ResponseRatioIndex.h"
+
+// Highest Response Ratio Next: non-preemptive, the waiting process with the largest
+// (Tw + Ts) / Ts runs next
+struct HRRNPolicy
+{
+    typedef ResponseRatioIndex ReadyQueue;
+
+    ReadyQueue ready_q;        // finds the highest response ratio without scanning every waiting process
+    ProcessId on_cpu;          // id of process on cpu
+    bool cpu_idle;             // use to determine whether cpu is in use
+
+    HRRNPolicy() : on_cpu(no_process), cpu_idle(true) {}
+
+    void onArrival(SimulationCore& sim, ProcessId p)
+    {
+        ProcessTable& table = sim.processTable();
+
+        if (cpu_idle) // cpu is not executing a process, and there are no processes waiting in ready queue
+        {
+            cpu_idle = false; // cpu is no longer idle
+            on_cpu = p;       // assign process to cpu to execute
+            sim.trace(trace_dispatch, p);
+            sim.scheduleDeparture(sim.now() + table.service_time[p], p);
+        }
+        else // cpu is executing a process but HRRN is not preemptive so process arriving must be placed in ready queue
+        {
+            ready_q.push(p, table.arrival_time[p], table.service_time[p]); // index keeps waiting processes ordered by response ratio as the clock advances
+        }
+    }
+
+    void onDeparture(SimulationCore& sim, ProcessId p)
+    {
+        ProcessTable& table = sim.processTable();
+
+        sim.addCpuUsage(table.service_time[p]);
+
+        if (ready_q.empty()) cpu_idle = true; // if no processes are waiting to be executed, the cpu has no work to do
+        else
+        {
+            sim.sampleQueue(ready_q.size()); // count the amount of processes waiting in ready queue at time of the current process's completion
+
+            on_cpu = ready_q.popHighest(sim.now()); // remove from the ready queue the process with highest response ratio (Tw + Ts) / Ts
+            sim.trace(trace_dispatch, on_cpu);
+
+            table.completion_time[on_cpu] = sim.now() + table.service_time[on_cpu]; // establish completion time of this process
+            sim.scheduleDeparture(table.completion_time[on_cpu], on_cpu);           // create a departure event for the process assigned to the cpu
+        }
+
+        sim.complete(p);
+    }
+
+    void onTimeSlice(SimulationCore&, ProcessId) {} // HRRN never slices
+
+    std::size_t waiting() const { return ready_q.size(); }
+    bool idle() const { return cpu_idle; }
+
+    // hand the next waiting process to another core (highest response ratio)
+    ProcessId steal(SimulationCore& sim) { return ready_q.popHighest(sim.now()); }
+
+    // lower runs sooner, so the response ratio is negated
+    double nextPriority(SimulationCore& sim)
+    {
+        const ProcessTable& table = sim.processTable();
+        ProcessId p = ready_q.highest(sim.now());
+        return -((sim.now() - table.arrival_time[p]) + table.service_time[p]) / table.service_time[p];
+    }
+
+    static const unsigned int snapshot_tag = 3;
+
+    // snapshot: cpu state, then the waiting processes in arrival order at the index
+    void save(SnapshotWriter& w, SnapshotNumbering& numbering) const
+    {
+        std::vector<ProcessId> in_order;
+        ready_q.contents(in_order);
+
+        w.put(static_cast<unsigned char>(cpu_idle));
+        w.put(numbering(cpu_idle ? no_process : on_cpu));
+        w.put(static_cast<unsigned int>(in_order.size()));
+        for (std::size_t i = 0; i < in_order.size(); ++i) w.put(numbering(in_order[i]));
+    }
+
+    bool restore(SnapshotReader& r, const RestoreContext& context)
+    {
+        unsigned char idle = 1;
+        unsigned int n = 0;
+
+        r.get(idle);
+        cpu_idle = idle != 0;
+        on_cpu = context.process(r);
+
+        ready_q = ReadyQueue();
+        r.get(n);
+        for (unsigned int i = 0; i < n && r.good(); ++i)
+        {
+            ProcessId p = context.required(r);
+            if (p == no_process) break;
+
+            ready_q.push(p, context.table->arrival_time[p], context.table->service_time[p]);
+        }
+
+        return r.good() && (cpu_idle || on_cpu != no_process);
+    }
+};
+
+#endif // HRRN_POLICY_H
@@ -0,0 +1,117 @@
+#include "IndexedHeapEventSet.h"
+
+namespace
+{
+    const std::size_t arity = 4;                         // children per node: shallower than binary, siblings share a cache line
+    const std::size_t npos = static_cast<std::size_t>(-1);
+}
+
+EventHandle IndexedHeapEventSet::push(const Event& e)
+{
+    EventHandle h;
+
+    if (free_handles.empty())
+    {
+        h = static_cast<EventHandle>(position.size());
+        position.push_back(npos);
+    }
+    else
+    {
+        h = free_handles.back();
+        free_handles.pop_back();
+    }
+
+    heap.push_back(Entry(e, h));
+    position[h] = heap.size() - 1;
+    siftUp(heap.size() - 1);
+
+    return h;
+}
+
+bool IndexedHeapEventSet::cancel(EventHandle h)
+{
+    if (h >= position.size() || position[h] == npos) return false; // already fired or cancelled
+
+    remove(position[h]);
+    return true;
+}
+
+void IndexedHeapEventSet::reschedule(EventHandle h, const Event& e)
+{
+    std::size_t i = position[h];
+
+    heap[i].e = e;
+    siftUp(i);
+    siftDown(position[h]);
+}
+
+void IndexedHeapEventSet::place(std::size_t i, const Entry& x)
+{
+    heap[i] = x;
+    position[x.h] = i;
+}
+
+void IndexedHeapEventSet::siftUp(std::size_t i)
+{
+    Entry x = heap[i];
+
+    while (i > 0)
+    {
+        std::size_t parent = (i - 1) / arity;
+        if (heap[parent].e.time <= x.e.time) break;
+
+        place(i, heap[parent]); // move parent down into the hole
+        i = parent;
+    }
+
+    place(i, x);
+}
+
+void IndexedHeapEventSet::siftDown(std::size_t i)
+{
+    Entry x = heap[i];
+    std::size_t n = heap.size();
+
+    for (;;)
+    {
+        std::size_t first = arity * i + 1;
+        if (first >= n) break;
+
+        std::size_t last = first + arity < n ? first + arity : n,
+                    child = first;
+
+        for (std::size_t c = first + 1; c < last; ++c)
+            if (heap[c].e.time < heap[child].e.time) child = c; // earliest child
+
+        if (x.e.time <= heap[child].e.time) break;
+
+        place(i, heap[child]); // move earliest child up into the hole
+        i = child;
+    }
+
+    place(i, x);
+}
+
+void IndexedHeapEventSet::remove(std::size_t i)
+{
+    position[heap[i].h] = npos;
+    free_handles.push_back(heap[i].h);
+
+    if (i + 1 < heap.size())
+    {
+        heap[i] = heap.back(); // fill the hole with the last entry and restore heap order around it
+        heap.pop_back();
+        position[heap[i].h] = i;
+
+        EventHandle moved = heap[i].h;
+        siftUp(i);
+        siftDown(position[moved]);
+    }
+    else heap.pop_back();
+}
+
+void IndexedHeapEventSet::pending(std::vector<PendingEvent>& out) const
+{
+    for (std::size_t i = 0; i < heap.size(); ++i)
+        out.push_back(PendingEvent(heap[i].e, heap[i].h));
+}
@@ -0,0 +1,40 @@
+#ifndef INDEXED_HEAP_EVENT_SET_H
+#define INDEXED_HEAP_EVENT_SET_H
+
+#include <vector>      // for heap array and handle table
+#include "EventSet.h"
+
+// Future-event set backed by an indexed 4-ary heap. Each handle records the heap
+// position of its event, so cancel and reschedule are O(log n) like push and pop.
+class IndexedHeapEventSet : public EventSet
+{
+public:
+    EventHandle push(const Event& e);
+    const Event& top() { return heap.front().e; }
+    void pop() { remove(0); }
+    bool cancel(EventHandle h);
+    void reschedule(EventHandle h, const Event& e);
+    bool empty() const { return heap.empty(); }
+    std::size_t size() const { return heap.size(); }
+    void pending(std::vector<PendingEvent>& out) const;
+
+private:
+    struct Entry
+    {
+        Event e;
+        EventHandle h; // handle that tracks this entry's position
+
+        Entry(const Event& new_e, EventHandle new_h) : e(new_e), h(new_h) {}
+    };
+
+    void place(std::size_t i, const Entry& x); // store an entry and record its position
+    void siftUp(std::size_t i);
+    void siftDown(std::size_t i);
+    void remove(std::size_t i);                // delete the entry at heap position i
+
+    std::vector<Entry> heap;                   // earliest event at front
+    std::vector<std::size_t> position;         // heap position of each handle (npos if not pending)
+    std::vector<EventHandle> free_handles;     // handles available for reuse
+};
+
+#endif // INDEXED_HEAP_EVENT_SET_H
@@ -0,0 +1,38 @@
+#include "JobSource.h"
+
+SyntheticJobSource::SyntheticJobSource(int l, double s_t, unsigned long seed, bool antithetic) :
+    arrival_stream(1.0 / l, seed, 0, antithetic), service_stream(s_t, seed, 1, antithetic), last_arrival(0.0), started(false) {}
+
+bool SyntheticJobSource::next(double& arrival_time, double& service_time)
+{
+    double gap = arrival_stream.next(); // the first job's gap is drawn and dropped, so seeded runs keep their streams
+
+    if (started) last_arrival += gap;
+    started = true;
+
+    arrival_time = last_arrival;
+    service_time = service_stream.next();
+
+    return true;
+}
+
+void SyntheticJobSource::save(SnapshotWriter& w) const
+{
+    arrival_stream.save(w);
+    service_stream.save(w);
+    w.put(last_arrival);
+    w.put(static_cast<unsigned char>(started));
+}
+
+bool SyntheticJobSource::restore(SnapshotReader& r)
+{
+    unsigned char was_started = 0;
+
+    arrival_stream.restore(r);
+    service_stream.restore(r);
+    r.get(last_arrival);
+    r.get(was_started);
+    started = was_started != 0;
+
+    return r.good();
+}
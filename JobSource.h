@@ -0,0 +1,43 @@
+#ifndef JOB_SOURCE_H
+#define JOB_SOURCE_H
+
+#include "ExponentialStream.h"
+
+// Supplies the workload as (arrival time, service time) pairs in non-decreasing arrival
+// order. The simulator keeps exactly one arrival pending, so a source is asked for the
+// next job only when the clock reaches the previous one.
+class JobSource
+{
+public:
+    virtual ~JobSource() {}
+
+    virtual bool next(double& arrival_time, double& service_time) = 0; // false once the workload is exhausted
+
+    // position in the workload, for snapshots; restore expects a source built the same way
+    virtual void save(SnapshotWriter& w) const = 0;
+    virtual bool restore(SnapshotReader& r) = 0;
+};
+
+// Poisson arrivals at rate lambda with exponential service times of mean Ts, drawn from
+// two independent streams of the seed, so job i's draws do not depend on the scheduler
+// (common random numbers). The antithetic source draws from 1 - U in place of every U.
+// The first process arrives at time 0.
+class SyntheticJobSource : public JobSource
+{
+public:
+    // Constructor
+    SyntheticJobSource(int l, double s_t, unsigned long seed, bool antithetic = false);
+
+    bool next(double& arrival_time, double& service_time);
+
+    void save(SnapshotWriter& w) const;
+    bool restore(SnapshotReader& r);
+
+private:
+    ExponentialStream arrival_stream, // inter-arrival times, mean 1 / lambda
+                      service_stream; // service times, mean Ts
+    double last_arrival;              // arrival time of the previous job
+    bool started;                     // whether the first job has been handed out
+};
+
+#endif // JOB_SOURCE_H
@@ -0,0 +1,213 @@
+#include <algorithm>   // for min
+#include <cstring>     // for memcpy
+#include "LindleyEngine.h"
+
+namespace
+{
+    const std::size_t lanes = LindleyEngine::lanes,
+                      rows = ExponentialBatch::block;
+
+    // where every lane's recursion stands after its latest job, and the jobs of the
+    // latest block
+    struct Lanes
+    {
+        double arrival[lanes],    // A(n)
+               departure[lanes],  // D(n)
+               turnaround[lanes], // accumulated as SimulationCore::complete does
+               cpu_time[lanes];   // accumulated as FCFSPolicy charges it, at each start
+
+        double arrivals[rows][lanes],   // each job of the block
+               departures[rows][lanes];
+        double draws[rows][2 * lanes];  // the block's gaps, then its services
+    };
+
+    // Advance every lane by the block's first n jobs. The first job of a run arrives at
+    // 0: its gap is dropped, as SyntheticJobSource drops it. Everything the loop touches
+    // lives in one object, so it vectorizes without runtime alias checks.
+    VECTOR_CLONES void recurse(Lanes& s, std::size_t n, bool first)
+    {
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            const double keep = first && j == 0 ? 0.0 : 1.0;
+
+            for (std::size_t l = 0; l < lanes; ++l)
+            {
+                double arrival = s.arrival[l] + keep * s.draws[j][l],
+                       service = s.draws[j][lanes + l],
+                       previous = s.departure[l];
+                bool idle = arrival >= previous; // the previous job left an empty queue behind
+
+                s.departure[l] = (idle ? arrival : previous) + service; // start + service, the completion column
+                s.cpu_time[l] += service;
+                s.turnaround[l] += s.departure[l] - arrival;
+                s.arrival[l] = arrival;
+
+                s.arrivals[j][l] = arrival;
+                s.departures[j][l] = s.departure[l];
+            }
+        }
+    }
+
+    // Every lane's jobs that may still be in the system, by departure time (which is FIFO
+    // order), for W: the ready queue FCFS samples at each departure holds every later job
+    // that arrived before it, so each arrival adds one for every earlier job of its run
+    // that has yet to leave.
+    struct InSystem
+    {
+        std::vector<double> departures[lanes];
+        std::size_t head[lanes];               // first entry that had not departed by the latest arrival
+        unsigned long long dropped[lanes],     // entries compacted away before departures[l][0]
+                           queued[lanes];      // sum of the sampled queue lengths
+
+        InSystem()
+        {
+            for (std::size_t l = 0; l < lanes; ++l) head[l] = dropped[l] = queued[l] = 0;
+        }
+
+        // jobs first .. first + n - 1 of the block. A job's own departure never counts as
+        // gone by its arrival (it may coincide with a zero service), so merging the arrivals
+        // into the departures never runs off the end; the lanes merge in step so their
+        // dependency chains overlap.
+        void add(unsigned long long first, std::size_t n, const Lanes& s)
+        {
+            const double* left[lanes];
+            std::size_t i[lanes],
+                        k[lanes];
+
+            for (std::size_t l = 0; l < lanes; ++l)
+            {
+                for (std::size_t j = 0; j < n; ++j) departures[l].push_back(s.departures[j][l]);
+                left[l] = &departures[l][0];
+                i[l] = 0;
+                k[l] = head[l];
+            }
+
+            for (bool merging = true; merging; )
+            {
+                merging = false;
+                for (std::size_t l = 0; l < lanes; ++l)
+                {
+                    if (i[l] == n) continue;
+
+                    std::size_t ahead = first + i[l] - dropped[l] - k[l], // earlier jobs not yet seen to leave
+                                gone = (left[l][k[l]] <= s.arrivals[i[l]][l]) & (ahead != 0);
+                    queued[l] += ahead & (gone - 1); // as a mask: no branch on a coin flip
+                    k[l] += gone;
+                    i[l] += 1 - gone;
+                    merging = true;
+                }
+            }
+
+            for (std::size_t l = 0; l < lanes; ++l)
+            {
+                head[l] = k[l];
+                if (head[l] >= 4096 && 2 * head[l] >= departures[l].size()) // keep to the jobs in the system
+                {
+                    departures[l].erase(departures[l].begin(), departures[l].begin() + head[l]);
+                    dropped[l] += head[l];
+                    head[l] = 0;
+                }
+            }
+        }
+
+        // an arrival to lane l after its run's last job, before that job's departure: it
+        // waits behind every job of the run that has not left
+        void arrive(std::size_t l, double arrival)
+        {
+            while (departures[l][head[l]] <= arrival) ++head[l]; // the last departure is later
+            queued[l] += departures[l].size() - head[l];
+        }
+    };
+}
+
+LindleyEngine::LindleyEngine(unsigned long j) : jobs(j ? j : 1) {}
+
+bool LindleyEngine::add(const LindleyRun& r)
+{
+    if (runs.size() == lanes) return false;
+
+    runs.push_back(r);
+    return true;
+}
+
+std::vector<SimulationResults> LindleyEngine::run()
+{
+    std::vector<SimulationResults> results(runs.size());
+    if (runs.empty()) return results;
+
+    ExponentialBatch batch;
+    for (std::size_t l = 0; l < lanes; ++l)
+    {
+        const LindleyRun& r = runs[std::min(l, runs.size() - 1)]; // spare lanes repeat the last run
+        batch.setStream(l, 1.0 / r.lambda, r.seed, 0, r.antithetic); // SyntheticJobSource's streams
+        batch.setStream(lanes + l, r.inverse_mu, r.seed, 1, r.antithetic);
+    }
+
+    Lanes s = Lanes();
+    InSystem in_system;
+    unsigned long long done = 0; // jobs recursed so far
+    std::size_t j = rows;        // next row of the block
+
+    while (done < jobs)
+    {
+        batch.refill();
+        for (std::size_t i = 0; i < rows; ++i) std::memcpy(s.draws[i], batch.row(i), sizeof s.draws[i]);
+        j = static_cast<std::size_t>(std::min<unsigned long long>(rows, jobs - done));
+
+        recurse(s, j, done == 0);
+
+        in_system.add(done, j, s);
+
+        done += j;
+    }
+
+    // The run stops at the last job's departure, D(jobs - 1). That departure starts the
+    // next job, charging its service, if it is waiting; every job that arrived before it
+    // was in the queues sampled up to then.
+    bool ended[lanes] = { false };
+    std::size_t open = lanes;
+
+    for (unsigned long long job = jobs; open > 0; ++job, ++j)
+    {
+        if (j == rows)
+        {
+            batch.refill();
+            j = 0;
+        }
+
+        const double* draws = batch.row(j);
+
+        for (std::size_t l = 0; l < lanes; ++l)
+        {
+            if (ended[l]) continue;
+
+            double arrival = s.arrival[l] + draws[l];
+            bool idle = arrival >= s.departure[l];
+
+            if (job == jobs && !idle) s.cpu_time[l] += draws[lanes + l];
+            s.arrival[l] = arrival;
+
+            if (idle)
+            {
+                ended[l] = true;
+                --open;
+            }
+            else in_system.arrive(l, arrival);
+        }
+    }
+
+    for (std::size_t l = 0; l < runs.size(); ++l)
+    {
+        SimulationResults& r = results[l];
+        double elapsed = s.departure[l];
+
+        r.turnaround_time = s.turnaround[l] / jobs;
+        r.processes_in_queue = static_cast<double>(in_system.queued[l]) / jobs;
+        r.cpu_usage = s.cpu_time[l] / elapsed;
+        r.throughput = jobs / elapsed;
+        r.jobs = jobs;
+        r.distributions = false;
+    }
+
+    return results;
+}
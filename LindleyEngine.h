@@ -0,0 +1,44 @@
+#ifndef LINDLEY_ENGINE_H
+#define LINDLEY_ENGINE_H
+
+#include <vector>      // for the runs and their results
+#include "ExponentialStream.h"
+#include "SimulationResults.h"
+
+// One single-cpu FCFS configuration for LindleyEngine, seeded as Simulator seeds it
+struct LindleyRun
+{
+    int lambda;            // average arrival rate
+    double inverse_mu;     // average service time
+    unsigned long seed;
+    bool antithetic;       // draw from 1 - U, as Simulator's antithetic twin does
+
+    LindleyRun(int l, double s_t, unsigned long s, bool a = false) : lambda(l), inverse_mu(s_t), seed(s), antithetic(a) {}
+};
+
+// First Come First Serve on one cpu without an event set. Jobs start in arrival order,
+// so each departure follows from the previous one by the Lindley recursion, taken in
+// absolute times: D(n) = max(A(n), D(n-1)) + S(n). Up to `lanes` independent runs
+// (replications, or points of a sweep) advance side by side, one per vector lane, and
+// draw their arrivals and services from an ExponentialBatch.
+//
+// Each run reports the Tq, W, Rho and throughput that Simulator reports for the same
+// configuration and seed, accumulated in the same order, so the values are identical.
+// Distributions and time averages are not recorded.
+class LindleyEngine
+{
+public:
+    static const std::size_t lanes = ExponentialBatch::streams / 2; // an arrival and a service stream each
+
+    // Constructor: each run stops at `jobs` completions (at least 1)
+    explicit LindleyEngine(unsigned long jobs = 10000);
+
+    bool add(const LindleyRun& r);        // false once all lanes are taken
+    std::vector<SimulationResults> run(); // results in the order the runs were added
+
+private:
+    unsigned long jobs;
+    std::vector<LindleyRun> runs;
+};
+
+#endif // LINDLEY_ENGINE_H
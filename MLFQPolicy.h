@@ -0,0 +1,273 @@
+#ifndef MLFQ_POLICY_H
+#define MLFQ_POLICY_H
+
+#include <cmath>       // for floor, ldexp
+#include <vector>      // for per-level quanta
+#include "SimulationCore.h"
+#include "PriorityArray.h"
+
+// Multi-level feedback queue settings: one quantum per level, highest priority first,
+// and how often every process is lifted back to the top level
+struct MLFQParameters
+{
+    std::vector<double> quanta; // time slice at each level (at most PriorityArray::max_levels)
+    double boost_period;        // time between priority boosts (0: never)
+
+    MLFQParameters() : boost_period(0) {}
+
+    // levels whose quanta double from q downwards, boosted every 100 base quanta
+    static MLFQParameters standard(double q, unsigned int levels = 3)
+    {
+        MLFQParameters m;
+        for (unsigned int l = 0; l < levels; ++l) m.quanta.push_back(std::ldexp(q, static_cast<int>(l))); // q * 2^l, exact for any level
+        m.boost_period = 100.0 * q;
+        return m;
+    }
+};
+
+// Multi-level feedback queue: new processes start at the top level, a process that uses
+// up its quantum drops one level, and an arrival preempts a process running at a lower
+// level. A preempted process resumes first within its level and finishes the slice it
+// was cut off from. Every boost period all processes return to the top level; since
+// nothing reads the levels between events, the boost is applied at the first scheduling
+// decision after it falls due rather than by an event of its own.
+struct MLFQPolicy
+{
+    typedef PriorityArray ReadyQueue;
+
+    ReadyQueue ready_q;
+    ProcessId on_cpu;             // id of process on cpu
+    bool cpu_idle;                // use to determine whether cpu is in use
+    EventHandle cpu_event;        // pending departure or slice end of the process on cpu (rescheduled on preemption)
+    double slice_start,           // when the process on cpu was dispatched
+           slice;                 // cpu time it was given then
+    std::vector<double> quanta,   // time slice of each level
+                        partial;  // rest of a slice cut short by preemption, owed to the front of each level (0: none)
+    double boost_period,          // time between boosts (0: never)
+           next_boost;            // when the next boost falls due
+
+    explicit MLFQPolicy(const MLFQParameters& m) :
+        ready_q(static_cast<unsigned int>(m.quanta.size())), on_cpu(no_process), cpu_idle(true), cpu_event(0),
+        slice_start(0), slice(0), quanta(m.quanta), partial(ready_q.levels(), 0.0),
+        boost_period(m.boost_period), next_boost(m.boost_period) {}
+
+    void onArrival(SimulationCore& sim, ProcessId p)
+    {
+        boostIfDue(sim);
+
+        ProcessTable& table = sim.processTable();
+
+        if (cpu_idle)
+        {
+            cpu_idle = false;
+            on_cpu = p;
+            start(sim, quanta[table.level[p]], false);
+        }
+        else if (table.level[p] < table.level[on_cpu]) // a higher level always runs first
+        {
+            ProcessId temp = on_cpu;
+            double used = sim.now() - slice_start;
+
+            table.remaining_time[temp] -= used;
+            sim.addCpuUsage(used - slice); // the slice was charged whole when it started
+            partial[table.level[temp]] = slice - used;
+            ready_q.pushFront(temp, table.level[temp]);
+            sim.trace(trace_preempt, temp);
+
+            on_cpu = p;
+            start(sim, quanta[table.level[p]], true); // the cpu's pending event moves to the new process
+        }
+        else ready_q.push(p, table.level[p]);
+    }
+
+    void onDeparture(SimulationCore& sim, ProcessId p)
+    {
+        if (cpu_idle || on_cpu != p) // preemption reschedules the cpu's event, so this only happens if an event slipped through
+        {
+            sim.staleEvent();
+            return;
+        }
+
+        boostIfDue(sim);
+
+        ProcessTable& table = sim.processTable();
+
+        table.remaining_time[p] = 0;
+        sim.complete(p);
+
+        if (ready_q.empty()) cpu_idle = true;
+        else
+        {
+            sim.sampleQueue(ready_q.size()); // count the number of processes waiting in ready queue at this process's departure
+            dispatch(sim);
+        }
+    }
+
+    // p used its whole quantum: it drops a level and queues behind its new peers
+    void onTimeSlice(SimulationCore& sim, ProcessId p)
+    {
+        if (cpu_idle || on_cpu != p)
+        {
+            sim.staleEvent();
+            return;
+        }
+
+        boostIfDue(sim);
+
+        ProcessTable& table = sim.processTable();
+        unsigned int& level = table.level[p];
+
+        table.remaining_time[p] -= slice;
+        if (level + 1 < ready_q.levels()) ++level;
+
+        if (ready_q.empty() || ready_q.highest() > level) start(sim, quanta[level], false); // nothing else is due first
+        else
+        {
+            ready_q.push(p, level);
+            sim.trace(trace_preempt, p);
+            dispatch(sim);
+        }
+    }
+
+    std::size_t waiting() const { return ready_q.size(); }
+    bool idle() const { return cpu_idle; }
+
+    // hand the next waiting process to another core (front of the highest level); it keeps
+    // its level but starts a fresh slice there
+    ProcessId steal(SimulationCore& sim)
+    {
+        boostIfDue(sim);
+        partial[ready_q.highest()] = 0.0;
+        return ready_q.pop();
+    }
+
+    double nextPriority(SimulationCore& sim) // lower runs sooner
+    {
+        boostIfDue(sim);
+        return ready_q.highest();
+    }
+
+    static const unsigned int snapshot_tag = 5;
+
+    // snapshot: cpu state with its pending event and slice, each level front to back, the
+    // owed slices and the boost clock; quanta are configuration, but the level count must match
+    void save(SnapshotWriter& w, SnapshotNumbering& numbering) const
+    {
+        w.put(static_cast<unsigned char>(cpu_idle));
+        w.put(numbering(cpu_idle ? no_process : on_cpu));
+        if (!cpu_idle)
+        {
+            w.put(cpu_event);
+            w.put(slice_start);
+            w.put(slice);
+        }
+
+        w.put(ready_q.levels());
+        for (unsigned int l = 0; l < ready_q.levels(); ++l)
+        {
+            const std::deque<ProcessId>& fifo = ready_q.level(l);
+
+            w.put(static_cast<unsigned int>(fifo.size()));
+            for (std::size_t i = 0; i < fifo.size(); ++i) w.put(numbering(fifo[i]));
+            w.put(partial[l]);
+        }
+
+        w.put(next_boost);
+    }
+
+    bool restore(SnapshotReader& r, const RestoreContext& context)
+    {
+        unsigned char idle = 1;
+        unsigned int levels = 0;
+
+        r.get(idle);
+        cpu_idle = idle != 0;
+        on_cpu = context.process(r);
+        if (!cpu_idle)
+        {
+            cpu_event = context.handle(r);
+            r.get(slice_start);
+            r.get(slice);
+        }
+
+        r.get(levels);
+        if (levels != ready_q.levels()) return false;
+
+        ready_q = ReadyQueue(levels);
+        for (unsigned int l = 0; l < levels && r.good(); ++l)
+        {
+            unsigned int n = 0;
+
+            r.get(n);
+            for (unsigned int i = 0; i < n && r.good(); ++i)
+            {
+                ProcessId p = context.required(r);
+                if (p == no_process) break;
+
+                context.table->level[p] = l;
+                ready_q.push(p, l);
+            }
+            r.get(partial[l]);
+        }
+
+        r.get(next_boost);
+
+        return r.good() && (cpu_idle || on_cpu != no_process);
+    }
+
+private:
+    // put on_cpu to work for up to s; the event ending the slice is a departure if the process finishes within it.
+    // The slice's cpu time is charged as it starts, as RRPolicy::runSlice does, so one level
+    // without boosts gives Round Robin's results exactly on one cpu
+    void start(SimulationCore& sim, double s, bool replace)
+    {
+        ProcessTable& table = sim.processTable();
+        double r = table.remaining_time[on_cpu];
+
+        slice_start = sim.now();
+        sim.trace(trace_dispatch, on_cpu);
+
+        if (r <= s)
+        {
+            slice = r;
+            table.completion_time[on_cpu] = sim.now() + r;
+            if (replace) sim.rescheduleDeparture(cpu_event, table.completion_time[on_cpu], on_cpu);
+            else cpu_event = sim.scheduleDeparture(table.completion_time[on_cpu], on_cpu);
+        }
+        else
+        {
+            slice = s;
+            table.completion_time[on_cpu] = sim.now() + r; // if it were not preempted again
+            if (replace) sim.rescheduleTimeSlice(cpu_event, sim.now() + s, on_cpu);
+            else cpu_event = sim.scheduleTimeSlice(sim.now() + s, on_cpu);
+        }
+
+        sim.addCpuUsage(slice);
+    }
+
+    // run the front of the highest non-empty level, with any slice it is owed
+    void dispatch(SimulationCore& sim)
+    {
+        unsigned int l = ready_q.highest();
+        double s = partial[l] > 0.0 ? partial[l] : quanta[l];
+
+        partial[l] = 0.0;
+        on_cpu = ready_q.pop();
+        start(sim, s, false);
+    }
+
+    // lift every process to the top level if a boost has fallen due since the last decision
+    void boostIfDue(SimulationCore& sim)
+    {
+        if (boost_period <= 0.0 || sim.now() < next_boost) return;
+
+        std::vector<unsigned int>& level = sim.processTable().level;
+
+        ready_q.merge(level);
+        if (!cpu_idle) level[on_cpu] = 0;
+        partial.assign(partial.size(), 0.0);
+        next_boost = (std::floor(sim.now() / boost_period) + 1.0) * boost_period;
+    }
+};
+
+#endif // MLFQ_POLICY_H
@@ -0,0 +1,199 @@
+#ifndef MULTI_CORE_ENGINE_H
+#define MULTI_CORE_ENGINE_H
+
+#include <vector>      // for cores and their usage
+#include "SimulationCore.h"
+#include "BalanceStrategy.h"
+#include "ExponentialStream.h"
+
+// Event loop for k cpus, each running its own instance of Policy with its own ready
+// queue. Every process records the core it belongs to, so departures and time slices go
+// straight to that core's handlers. Arrivals are placed, and dry cores refilled,
+// according to the balancing strategy (see BalanceStrategy.h).
+template <class Policy>
+class MultiCoreEngine : public SimulationCore
+{
+public:
+    // Constructor
+    MultiCoreEngine(const Policy& p, int k, BalanceStrategy b, JobSource* source,
+                    EventSetType e_s = indexed_heap, unsigned long seed = 1, unsigned long jobs = 10000) :
+        SimulationCore(source, e_s, jobs), cores(k, p), usage(k, 0.0), strategy(b),
+        placement(seed, 2), migrations(0)
+    {
+        setFastForward(false); // other cores' events interleave with any stretch a policy would skip
+    }
+
+    SimulationResults run()
+    {
+        while (!finished())
+        {
+            Event e = nextEvent();
+            std::size_t c;
+
+            switch(e.type)
+            {
+                case arrival:
+                    c = place();
+                    processTable().cpu[e.p] = static_cast<unsigned int>(c);
+                    trace(trace_arrival, e.p);
+                    charge(c, &Policy::onArrival, e.p);
+                    scheduleArrival(); // schedule the next arrival to simulate continuous arrival of processes
+                    break;
+                case departure:
+                    c = processTable().cpu[e.p];
+                    trace(trace_departure, e.p);
+                    charge(c, &Policy::onDeparture, e.p);
+                    if (cores[c].idle()) refill(c);
+                    break;
+                case time_slice:
+                    c = processTable().cpu[e.p];
+                    trace(trace_time_slice, e.p);
+                    charge(c, &Policy::onTimeSlice, e.p);
+                    break;
+            }
+
+            std::size_t waiting = 0,
+                        busy = 0;
+            for (std::size_t i = 0; i < cores.size(); ++i)
+            {
+                waiting += cores[i].waiting();
+                if (!cores[i].idle()) ++busy;
+            }
+            observeLevels(waiting, busy);
+        }
+
+        SimulationResults r = results();
+
+        r.cpu_usage /= cores.size(); // utilization averaged over the cores
+        r.busy_fraction /= cores.size();
+        r.migrations = migrations;
+        for (std::size_t i = 0; i < cores.size(); ++i) r.core_utilization.push_back(usage[i] / elapsed());
+
+        return r;
+    }
+
+    void resetStatistics()
+    {
+        SimulationCore::resetStatistics();
+        usage.assign(cores.size(), 0.0);
+        migrations = 0;
+    }
+
+protected:
+    unsigned int policyTag() const { return Policy::snapshot_tag; }
+    unsigned int cpuCount() const { return static_cast<unsigned int>(cores.size()); }
+
+    void savePolicy(SnapshotWriter& w, SnapshotNumbering& numbering) const
+    {
+        for (std::size_t i = 0; i < cores.size(); ++i)
+        {
+            cores[i].save(w, numbering);
+            w.put(usage[i]);
+        }
+        placement.save(w);
+        w.put(static_cast<unsigned long long>(migrations));
+    }
+
+    bool restorePolicy(SnapshotReader& r, const RestoreContext& context)
+    {
+        unsigned long long moved = 0;
+
+        for (std::size_t i = 0; i < cores.size(); ++i)
+        {
+            cores[i].restore(r, context);
+            r.get(usage[i]);
+        }
+        placement.restore(r);
+        r.get(moved);
+        migrations = static_cast<unsigned long>(moved);
+
+        return r.good();
+    }
+
+private:
+    typedef void (Policy::*Handler)(SimulationCore&, ProcessId);
+
+    // run a handler on core c, attributing the cpu time it commits to that core
+    void charge(std::size_t c, Handler h, ProcessId p)
+    {
+        double before = cpuTime();
+        (cores[c].*h)(*this, p);
+        usage[c] += cpuTime() - before;
+    }
+
+    std::size_t randomCore() { return static_cast<std::size_t>(placement.next() % cores.size()); }
+
+    // processes on a core, running or waiting
+    std::size_t load(std::size_t c) const { return cores[c].waiting() + (cores[c].idle() ? 0 : 1); }
+
+    // choose the core an arriving process joins
+    std::size_t place()
+    {
+        switch(strategy)
+        {
+            case global_queue:
+            {
+                std::size_t shortest = 0;
+                for (std::size_t i = 0; i < cores.size(); ++i)
+                {
+                    if (cores[i].idle()) return i;
+                    if (cores[i].waiting() < cores[shortest].waiting()) shortest = i;
+                }
+                return shortest;
+            }
+            case two_choices:
+            {
+                std::size_t a = randomCore(),
+                            b = randomCore();
+                return load(b) < load(a) ? b : a;
+            }
+            case random_push:
+            case work_stealing:
+            default:
+                return randomCore();
+        }
+    }
+
+    // core c has nothing to run: pull a waiting process from another core if the strategy allows
+    void refill(std::size_t c)
+    {
+        std::size_t victim = cores.size();
+
+        if (strategy == global_queue) // the most urgent waiting process anywhere, as a single shared queue would pick
+        {
+            double best = 0.0;
+            for (std::size_t i = 0; i < cores.size(); ++i)
+            {
+                if (cores[i].waiting() == 0) continue;
+
+                double priority = cores[i].nextPriority(*this);
+                if (victim == cores.size() || priority < best) { best = priority; victim = i; }
+            }
+        }
+        else if (strategy == work_stealing) // the longest queue
+        {
+            for (std::size_t i = 0; i < cores.size(); ++i)
+                if (cores[i].waiting() > 0 && (victim == cores.size() || cores[i].waiting() > cores[victim].waiting())) victim = i;
+        }
+
+        if (victim == cores.size()) return;
+
+        ProcessId p = cores[victim].steal(*this);
+        ProcessTable& table = processTable();
+
+        table.cpu[p] = static_cast<unsigned int>(c);
+        table.completion_time[p] = now() + table.remaining_time[p]; // runs to completion from now unless preempted again
+        ++migrations;
+        trace(trace_migrate, p);
+
+        charge(c, &Policy::onArrival, p); // the core is idle, so the policy dispatches it immediately
+    }
+
+    std::vector<Policy> cores;     // one scheduler instance (ready queue and cpu) per core
+    std::vector<double> usage;     // cpu time committed on each core
+    BalanceStrategy strategy;
+    Xoshiro256 placement;          // random core choices, a stream separate from the workload
+    unsigned long migrations;      // processes stolen by another core
+};
+
+#endif // MULTI_CORE_ENGINE_H
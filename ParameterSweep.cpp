@@ -0,0 +1,163 @@
+#include <algorithm>   // for max
+#include <cmath>       // for floor, log
+#include <cstdlib>     // for strtod
+#include <mutex>       // for serializing output rows
+#include <sstream>     // for formatting a row before writing it
+#include <string>      // for splitting specs
+#include "ParameterSweep.h"
+#include "AnalyticModel.h"
+#include "LindleyEngine.h"
+#include "Simulator.h"
+#include "WorkStealingPool.h"
+
+ParameterSweep::ParameterSweep(const std::vector<double>& schedules, const std::vector<double>& lambdas,
+                               const std::vector<double>& service_times, const std::vector<double>& quanta)
+{
+    for (std::size_t s = 0; s < schedules.size(); ++s)
+        for (std::size_t l = 0; l < lambdas.size(); ++l)
+            for (std::size_t t = 0; t < service_times.size(); ++t)
+                for (std::size_t q = 0; q < quanta.size(); ++q)
+                    points.push_back(SweepPoint(static_cast<int>(schedules[s]), static_cast<int>(lambdas[l]),
+                                                service_times[t], quanta[q]));
+}
+
+bool ParameterSweep::parseRange(const char* spec, std::vector<double>& values)
+{
+    std::stringstream items(spec);
+    std::string item;
+
+    while (std::getline(items, item, ','))
+    {
+        std::size_t first = item.find(':'),
+                    second = first == std::string::npos ? first : item.find(':', first + 1);
+        char* end;
+
+        if (first == std::string::npos) // single value
+        {
+            double v = strtod(item.c_str(), &end);
+            if (item.empty() || *end != '\0') return false;
+            values.push_back(v);
+            continue;
+        }
+
+        if (second == std::string::npos) return false;
+
+        double start = strtod(item.substr(0, first).c_str(), &end);
+        if (*end != '\0') return false;
+        double stop = strtod(item.substr(first + 1, second - first - 1).c_str(), &end);
+        if (*end != '\0') return false;
+        double step = strtod(item.substr(second + 1).c_str(), &end);
+        if (*end != '\0' || step <= 0 || stop < start) return false;
+
+        // count steps up front so accumulated rounding never drops or adds the last value
+        long n = static_cast<long>(std::floor((stop - start) / step + 1e-9));
+        for (long i = 0; i <= n; ++i) values.push_back(start + i * step);
+    }
+
+    return !values.empty();
+}
+
+double ParameterSweep::cost(const SweepPoint& p)
+{
+    double rho = p.lambda * p.inverse_mu,
+           queue = rho < 0.99 ? rho / (1.0 - rho) : 100.0 * rho; // expected waiting processes (grows without bound past saturation)
+
+    double events = 2.0; // arrival and departure per process
+    if (p.schedule == 4 && p.quantum > 0) events += p.inverse_mu / p.quantum; // time slices per process
+    if (p.schedule == 5 && p.quantum > 0) events += std::log(1.0 + p.inverse_mu / p.quantum); // quanta double per level
+
+    return events * (1.0 + std::log(1.0 + queue)); // ready-queue operations cost roughly log of its length
+}
+
+void ParameterSweep::run(std::ostream& out, unsigned threads, EventSetType event_set, unsigned long seed) const
+{
+    std::mutex output;
+
+    out << "point,scheduler,lambda,Ts,quantum,Tq,W,Rho,Throughput\n";
+
+    // First Come First Serve points run LindleyEngine::lanes at a time through the
+    // Lindley recursion, which gives the rows Simulator would; every other point is a
+    // task of its own. Lanes advance in step, so a group costs about its dearest point.
+    std::vector<std::vector<std::size_t> > tasks;
+    std::vector<double> costs;
+    std::size_t group = 0; // task collecting FCFS points, if tasks.size() > group
+
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        double c = cost(points[i]);
+
+        if (points[i].schedule != 1)
+        {
+            tasks.push_back(std::vector<std::size_t>(1, i));
+            costs.push_back(c);
+            continue;
+        }
+
+        if (group == tasks.size() || tasks[group].size() == LindleyEngine::lanes)
+        {
+            group = tasks.size();
+            tasks.push_back(std::vector<std::size_t>());
+            costs.push_back(0.0);
+        }
+        tasks[group].push_back(i);
+        costs[group] = std::max(costs[group], c);
+    }
+
+    WorkStealingPool pool(threads);
+
+    pool.run(costs, [&](std::size_t t)
+    {
+        const std::vector<std::size_t>& task = tasks[t];
+        std::vector<SimulationResults> results;
+
+        if (points[task[0]].schedule == 1)
+        {
+            LindleyEngine lindley;
+            for (std::size_t k = 0; k < task.size(); ++k)
+                lindley.add(LindleyRun(points[task[k]].lambda, points[task[k]].inverse_mu, seed));
+            results = lindley.run();
+        }
+        else
+        {
+            const SweepPoint& p = points[task[0]];
+
+            Simulator sim(p.schedule, p.lambda, p.inverse_mu, p.quantum, event_set, seed);
+            results.push_back(sim.run());
+        }
+
+        std::ostringstream row;
+        row.precision(10);
+        for (std::size_t k = 0; k < task.size(); ++k)
+        {
+            const SweepPoint& p = points[task[k]];
+            const SimulationResults& r = results[k];
+
+            row << task[k] << ',' << p.schedule << ',' << p.lambda << ',' << p.inverse_mu << ',' << p.quantum << ','
+                << r.turnaround_time << ',' << r.processes_in_queue << ',' << r.cpu_usage << ',' << r.throughput << '\n';
+        }
+
+        std::lock_guard<std::mutex> guard(output);
+        out << row.str();
+        out.flush(); // stream rows as they finish
+    });
+}
+
+void ParameterSweep::runAnalytic(std::ostream& out) const
+{
+    out << "point,scheduler,lambda,Ts,quantum,Tq,W,Rho,Throughput\n";
+
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        const SweepPoint& p = points[i];
+        AnalyticResults a = analyticResults(p.schedule, p.lambda, p.inverse_mu);
+
+        std::ostringstream row;
+        row.precision(10);
+        row << i << ',' << p.schedule << ',' << p.lambda << ',' << p.inverse_mu << ',' << p.quantum << ',';
+        if (a.exact) row << a.turnaround_time << ',' << a.processes_in_queue;
+        else row << ',';                     // HRRN: only bounds are known, so Tq and W are left empty
+        row << ',' << a.cpu_usage << ',' << a.throughput << '\n';
+
+        out << row.str();
+    }
+}
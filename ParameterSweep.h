@@ -0,0 +1,45 @@
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include <cstddef>     // for size_t
+#include <ostream>     // for CSV output
+#include <vector>      // for value lists and grid points
+#include "EventSet.h"
+
+// One configuration of the grid
+struct SweepPoint
+{
+    int schedule,          // type of schedule to simulate
+        lambda;            // average arrival rate
+    double inverse_mu,     // average service time
+           quantum;        // time interval length for RR schedule
+
+    SweepPoint(int s, int l, double s_t, double q) : schedule(s), lambda(l), inverse_mu(s_t), quantum(q) {}
+};
+
+// Cartesian grid over scheduler x lambda x Ts x quantum, run on a work-stealing pool.
+// Each finished point is streamed as one CSV row; rows carry the point's index since
+// they are written in completion order. First Come First Serve points skip the event
+// loop: they run in groups through LindleyEngine, with the same rows as Simulator's.
+class ParameterSweep
+{
+public:
+    // Constructor
+    ParameterSweep(const std::vector<double>& schedules, const std::vector<double>& lambdas,
+                   const std::vector<double>& service_times, const std::vector<double>& quanta);
+
+    // parse "v1,v2,..." where each item is a value or an inclusive range "start:stop:step"
+    static bool parseRange(const char* spec, std::vector<double>& values);
+
+    void run(std::ostream& out, unsigned threads, EventSetType event_set, unsigned long seed) const;
+    void runAnalytic(std::ostream& out) const; // M/M/1 expected values instead (see AnalyticModel.h), in point order
+
+    std::size_t size() const { return points.size(); }
+
+private:
+    static double cost(const SweepPoint& p); // relative run time estimate used to balance the pool
+
+    std::vector<SweepPoint> points;
+};
+
+#endif // PARAMETER_SWEEP_H
@@ -0,0 +1,58 @@
+#include "PriorityArray.h"
+
+PriorityArray::PriorityArray(unsigned int levels) :
+    fifo(levels < 1 ? 1 : levels > max_levels ? max_levels : levels), bitmap(0), count(0)
+{
+}
+
+void PriorityArray::push(ProcessId p, unsigned int l)
+{
+    fifo[l].push_back(p);
+    bitmap |= 1ULL << l;
+    ++count;
+}
+
+void PriorityArray::pushFront(ProcessId p, unsigned int l)
+{
+    fifo[l].push_front(p);
+    bitmap |= 1ULL << l;
+    ++count;
+}
+
+unsigned int PriorityArray::highest() const
+{
+#if defined(__GNUC__)
+    return static_cast<unsigned int>(__builtin_ctzll(bitmap)); // lowest set bit
+#else
+    unsigned int l = 0;
+    while (!(bitmap & (1ULL << l))) ++l;
+    return l;
+#endif
+}
+
+ProcessId PriorityArray::pop()
+{
+    unsigned int l = highest();
+    ProcessId p = fifo[l].front();
+
+    fifo[l].pop_front();
+    if (fifo[l].empty()) bitmap &= ~(1ULL << l);
+    --count;
+
+    return p;
+}
+
+void PriorityArray::merge(std::vector<unsigned int>& level)
+{
+    for (unsigned int l = 1; l < fifo.size(); ++l)
+    {
+        for (std::size_t i = 0; i < fifo[l].size(); ++i)
+        {
+            level[fifo[l][i]] = 0;
+            fifo[0].push_back(fifo[l][i]);
+        }
+        fifo[l].clear();
+    }
+
+    bitmap = fifo[0].empty() ? 0 : 1;
+}
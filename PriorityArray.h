@@ -0,0 +1,42 @@
+#ifndef PRIORITY_ARRAY_H
+#define PRIORITY_ARRAY_H
+
+#include <cstddef>     // for size_t
+#include <deque>       // for the per-level FIFOs
+#include <vector>      // for the levels
+#include "Process.h"
+
+// Ready queue for MLFQ, after the Linux O(1) scheduler's priority array: one FIFO per
+// priority level plus a bitmap with a bit set for every non-empty level. Finding the
+// highest-priority waiting process is a find-first-set on the bitmap, so push, pop and
+// selection cost the same however many processes are waiting. Level 0 is the highest;
+// the caller passes the level a process waits at (its ProcessTable::level).
+class PriorityArray
+{
+public:
+    static const unsigned int max_levels = 64; // one bit per level
+
+    // Constructor
+    explicit PriorityArray(unsigned int levels = 1);
+
+    // Mutators
+    void push(ProcessId p, unsigned int l);      // to the back of level l
+    void pushFront(ProcessId p, unsigned int l); // to the front of level l (resumes before its peers)
+    ProcessId pop();                             // remove and return the front of the highest non-empty level
+    void merge(std::vector<unsigned int>& level); // move every process to level 0, higher levels first, each in FIFO order, resetting level[p]
+
+    // Accessors
+    bool empty() const { return bitmap == 0; }
+    std::size_t size() const { return count; }
+    unsigned int levels() const { return static_cast<unsigned int>(fifo.size()); }
+    unsigned int highest() const; // highest non-empty level (the array must not be empty)
+    ProcessId front() const { return fifo[highest()].front(); } // process pop() would return
+    const std::deque<ProcessId>& level(unsigned int l) const { return fifo[l]; }
+
+private:
+    std::vector<std::deque<ProcessId> > fifo; // waiting processes of each level, oldest first
+    unsigned long long bitmap;                // bit l set while fifo[l] is not empty
+    std::size_t count;                        // waiting processes over all levels
+};
+
+#endif // PRIORITY_ARRAY_H
@@ -1,16 +1,10 @@
-#ifndef PROCESS_H
-#define PROCESS_H
-
-struct Process
-{
-    double service_time,
-           arrival_time,
-           remaining_time,
-           completion_time; // what time the process completes
-
-    Process(double s_t, double a_t, double r_t, double c_t) :
-            service_time(s_t), arrival_time(a_t), remaining_time(r_t),
-            completion_time(c_t) {}
-};
-
-#endif // PROCESS_H
\ No newline at end of file
+#ifndef PROCESS_H
+#define PROCESS_H
+
+// Identifies a process by its row in the ProcessTable. Events and ready queues hold ids
+// rather than pointers: they are half the size, and rows stay valid as the table grows.
+typedef unsigned int ProcessId;
+
+const ProcessId no_process = 0xFFFFFFFFu; // refers to no process
+
+#endif // PROCESS_H
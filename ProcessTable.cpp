@@ -0,0 +1,68 @@
+#include "ProcessTable.h"
+
+ProcessTable::ProcessTable()
+{
+    live_count = 0;
+    peak_live = 0;
+}
+
+ProcessId ProcessTable::acquire(double s_t, double a_t)
+{
+    if (free_ids.empty()) grow();
+
+    ProcessId p = free_ids.back();
+    free_ids.pop_back();
+
+    if (++live_count > peak_live) peak_live = live_count;
+
+    service_time[p] = s_t;
+    arrival_time[p] = a_t;
+    remaining_time[p] = s_t;
+    completion_time[p] = a_t + s_t;
+    cpu[p] = 0;
+    sequence[p] = 0;
+    level[p] = 0;
+
+    return p;
+}
+
+void ProcessTable::release(ProcessId p)
+{
+    if (p == no_process) return;
+
+    free_ids.push_back(p);
+    --live_count;
+}
+
+void ProcessTable::restoreHighWater(std::size_t peak)
+{
+    while (capacity() < peak) grow();
+    if (peak > peak_live) peak_live = peak;
+}
+
+std::size_t ProcessTable::footprint() const
+{
+    return service_time.capacity() * sizeof(double)   // double columns
+         + arrival_time.capacity() * sizeof(double)
+         + remaining_time.capacity() * sizeof(double)
+         + completion_time.capacity() * sizeof(double)
+         + cpu.capacity() * sizeof(unsigned int)       // integer columns
+         + sequence.capacity() * sizeof(unsigned int)
+         + level.capacity() * sizeof(unsigned int)
+         + free_ids.capacity() * sizeof(ProcessId);   // free list
+}
+
+void ProcessTable::grow()
+{
+    ProcessId p = static_cast<ProcessId>(capacity());
+
+    service_time.push_back(0.0);
+    arrival_time.push_back(0.0);
+    remaining_time.push_back(0.0);
+    completion_time.push_back(0.0);
+    cpu.push_back(0);
+    sequence.push_back(0);
+    level.push_back(0);
+
+    free_ids.push_back(p);
+}
@@ -0,0 +1,50 @@
+#ifndef PROCESS_TABLE_H
+#define PROCESS_TABLE_H
+
+#include <cstddef>     // for size_t
+#include <vector>      // for the columns and free list
+#include "Process.h"
+
+// Every process in the system, stored column by column and addressed by ProcessId. Ids
+// of departed processes are recycled through a free list, so the columns only grow to
+// the peak number of processes alive at once. A policy reads just the columns it needs,
+// and ready queues and events carry 4-byte ids instead of pointers.
+//
+// Ids stay valid while the table grows, but references into the columns do not: take
+// them after the last acquire().
+class ProcessTable
+{
+public:
+    // Constructor
+    ProcessTable();
+
+    // Mutators
+    ProcessId acquire(double s_t, double a_t); // a new process with all of s_t remaining, due at a_t + s_t
+    void release(ProcessId p);                 // the process has left the system; its id may be reused
+    void restoreHighWater(std::size_t peak);   // match a snapshot's peak and capacity
+
+    // Accessors
+    std::size_t live() const { return live_count; }           // processes currently in the system
+    std::size_t peakLive() const { return peak_live; }        // most processes alive at any one time
+    std::size_t capacity() const { return service_time.size(); } // rows allocated so far
+    std::size_t footprint() const;                             // bytes held by the table
+
+    // Columns, indexed by id
+    std::vector<double> service_time,
+                        arrival_time,
+                        remaining_time,
+                        completion_time; // what time the process completes
+    std::vector<unsigned int> cpu,       // core the process is assigned to (multi-core runs)
+                              sequence,  // arrival number, for event traces
+                              level;     // MLFQ priority level, 0 highest (kept across migrations)
+
+private:
+    void grow(); // add a row to every column and put it on the free list
+
+    std::vector<ProcessId> free_ids; // rows available for reuse
+
+    std::size_t live_count,          // rows currently handed out
+                peak_live;           // high-water mark of live_count
+};
+
+#endif // PROCESS_TABLE_H
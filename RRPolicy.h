@@ -0,0 +1,180 @@
+#ifndef RR_POLICY_H
+#define RR_POLICY_H
+
+#include <queue>       // for stl queue data structures
+#include "SimulationCore.h"
+
+// Round Robin: processes take turns on the cpu for at most one quantum at a time.
+//
+// Fast-forward: until the next arrival nothing can change the rotation, so slices that end
+// before it are played out in a loop instead of one time_slice event each (see runSlice).
+// The loop does the same arithmetic in the same order as the events would, so results are
+// identical; only the event counters differ.
+struct RRPolicy
+{
+    typedef std::queue<ProcessId> ReadyQueue;
+
+    ReadyQueue ready_q;
+    ProcessId on_cpu;          // id of process on cpu
+    bool cpu_idle;             // use to determine whether cpu is in use
+    double quantum;            // time interval length for RR schedule
+    unsigned long deferred;    // quanta played out without events, charged when the pending slice event fires
+
+    explicit RRPolicy(double q) : on_cpu(no_process), cpu_idle(true), quantum(q), deferred(0) {}
+
+    void onArrival(SimulationCore& sim, ProcessId p)
+    {
+        if (cpu_idle) // cpu is not currently executing a process
+        {
+            cpu_idle = false; // cpu executing a process
+            on_cpu = p;       // assign process to execute on cpu
+            runSlice(sim);
+        }
+        else ready_q.push(p); // cpu is currently working on a process. allow time slice for currently running process to handle arrival
+    }
+
+    void onDeparture(SimulationCore& sim, ProcessId p)
+    {
+        if (ready_q.empty()) cpu_idle = true; // no other processes are waiting
+        else
+        {
+            sim.sampleQueue(ready_q.size()); // count the amount of processes waiting in ready queue
+
+            on_cpu = ready_q.front(); // get first process waiting in queue and assign it to the cpu to execute
+            ready_q.pop();            // remove first element from ready queue
+            runSlice(sim);
+        }
+
+        sim.complete(p);
+    }
+
+    // Only create a time slice, if the remaining time on a process is greater than the duration of a time slice
+    void onTimeSlice(SimulationCore& sim, ProcessId p)
+    {
+        for (; deferred > 0; --deferred) sim.addCpuUsage(quantum); // the cpu time of skipped slices, in their order
+
+        if (sim.processTable().remaining_time[p] == 0) sim.scheduleDeparture(sim.now(), p); // departure will handle assigning next process to cpu
+        else if (ready_q.empty()) runSlice(sim); // nothing is waiting, so the current process keeps the cpu for another slice
+        else // at least one process waiting in ready queue and as the current process's quantum has expired, it is preempted by the waiting process
+        {
+            ready_q.push(p); // current executing process is preempted by first process waiting in ready queue
+            sim.trace(trace_preempt, p);
+
+            on_cpu = ready_q.front(); // assign process that was waiting in ready queue to cpu
+            ready_q.pop();            // remove process waiting in ready queue from ready queue
+            runSlice(sim);
+        }
+    }
+
+    std::size_t waiting() const { return ready_q.size(); }
+    bool idle() const { return cpu_idle; }
+
+    // hand the next waiting process to another core (head of the queue)
+    ProcessId steal(SimulationCore&)
+    {
+        ProcessId p = ready_q.front();
+        ready_q.pop();
+        return p;
+    }
+
+    double nextPriority(SimulationCore& sim) { return sim.processTable().arrival_time[ready_q.front()]; } // lower runs sooner
+
+    static const unsigned int snapshot_tag = 4;
+
+    // snapshot: cpu state, then the queue front to back; the quantum is configuration, so
+    // a restored run may continue with a different one, unless fast-forward has already
+    // played slices at the old quantum past the snapshot's clock: those cannot be undone,
+    // so such a snapshot only restores at the quantum it was taken with
+    void save(SnapshotWriter& w, SnapshotNumbering& numbering) const
+    {
+        ReadyQueue in_order(ready_q); // a copy to walk the queue
+
+        w.put(static_cast<unsigned char>(cpu_idle));
+        w.put(numbering(cpu_idle ? no_process : on_cpu));
+        w.put(static_cast<unsigned long long>(deferred));
+        w.put(quantum); // the deferred slices' length
+        w.put(static_cast<unsigned int>(in_order.size()));
+        for (; !in_order.empty(); in_order.pop()) w.put(numbering(in_order.front()));
+    }
+
+    bool restore(SnapshotReader& r, const RestoreContext& context)
+    {
+        unsigned char idle = 1;
+        unsigned int n = 0;
+        unsigned long long skipped = 0;
+        double played = quantum;
+
+        r.get(idle);
+        cpu_idle = idle != 0;
+        on_cpu = context.process(r);
+        r.get(skipped);
+        r.get(played);
+        deferred = static_cast<unsigned long>(skipped);
+
+        ready_q = ReadyQueue();
+        r.get(n);
+        for (unsigned int i = 0; i < n && r.good(); ++i) ready_q.push(context.required(r));
+
+        return r.good() && (cpu_idle || on_cpu != no_process) && (deferred == 0 || played == quantum);
+    }
+
+private:
+    // give the process on cpu one quantum, or what it has left if that is shorter
+    void runSlice(SimulationCore& sim)
+    {
+        ProcessTable& table = sim.processTable();
+        double r = table.remaining_time[on_cpu];
+
+        sim.trace(trace_dispatch, on_cpu);
+
+        if (r < quantum)
+        {
+            sim.addCpuUsage(r);
+            table.completion_time[on_cpu] = sim.now() + r;
+            table.remaining_time[on_cpu] = 0; // process will complete by the end of the next time slice allotted to it
+            sim.scheduleTimeSlice(sim.now() + r, on_cpu);
+        }
+        else // process requires service for longer than the time alloted in a single quantum or timeslice
+        {
+            sim.addCpuUsage(quantum);
+            table.completion_time[on_cpu] = sim.now() + quantum;
+            table.remaining_time[on_cpu] -= quantum; // by the end of the time slice to schedule, process will have executed quantum amount of time
+
+            double end = sim.now() + quantum;
+            if (sim.fastForward()) end = skipSlices(table, end, sim.nextArrival());
+            sim.scheduleTimeSlice(end, on_cpu);
+        }
+    }
+
+    // Play out the slice boundaries from t on that fall before the next arrival, as long as
+    // each one only rotates the queue and starts another full quantum, and return the
+    // boundary that needs a real event: the first at or after the arrival, the end of a
+    // process's last slice, or one followed by a short slice. The skipped slices' cpu time
+    // is charged when that event fires, since nothing reads it in between.
+    double skipSlices(ProcessTable& table, double t, double next_arrival)
+    {
+        std::vector<double>& remaining = table.remaining_time;
+
+        while (t < next_arrival && remaining[on_cpu] != 0)
+        {
+            ProcessId next = ready_q.empty() ? on_cpu : ready_q.front(); // who the slice event would run
+            if (remaining[next] < quantum) break;
+
+            if (next != on_cpu) // the slice event: the current process goes to the back of the queue
+            {
+                ready_q.push(on_cpu);
+                ready_q.pop();
+                on_cpu = next;
+            }
+
+            ++deferred; // and the slice it starts
+            table.completion_time[on_cpu] = t + quantum;
+            remaining[on_cpu] -= quantum;
+            t += quantum;
+        }
+
+        return t;
+    }
+};
+
+#endif // RR_POLICY_H
@@ -0,0 +1,114 @@
+#include <algorithm>   // for min, copy
+#include <atomic>      // for work counter shared by the threads
+#include <thread>      // for worker threads
+#include "ReplicationRunner.h"
+#include "LindleyEngine.h"
+#include "Simulator.h"
+
+namespace
+{
+    // one sample per seed: the run's metric, or the mean over its antithetic pair
+    std::vector<double> samples(const ReplicationSummary& s, double SimulationResults::*metric)
+    {
+        std::vector<double> x;
+
+        if (s.antithetic)
+            for (std::size_t i = 0; i + 1 < s.runs.size(); i += 2) x.push_back(0.5 * (s.runs[i].*metric + s.runs[i + 1].*metric));
+        else
+            for (std::size_t i = 0; i < s.runs.size(); ++i) x.push_back(s.runs[i].*metric);
+
+        return x;
+    }
+
+    // interval of other's samples minus base's, seed by seed
+    ConfidenceInterval difference(const ReplicationSummary& base, const ReplicationSummary& other, double SimulationResults::*metric)
+    {
+        std::vector<double> a = samples(base, metric),
+                            b = samples(other, metric); // the same seeds, so as many samples
+
+        for (std::size_t i = 0; i < b.size(); ++i) b[i] -= a[i];
+
+        return confidenceInterval(b);
+    }
+}
+
+PairedDifference pairedDifference(const ReplicationSummary& base, const ReplicationSummary& other)
+{
+    PairedDifference d;
+
+    d.turnaround_time = difference(base, other, &SimulationResults::turnaround_time);
+    d.processes_in_queue = difference(base, other, &SimulationResults::processes_in_queue);
+    d.cpu_usage = difference(base, other, &SimulationResults::cpu_usage);
+    d.throughput = difference(base, other, &SimulationResults::throughput);
+
+    return d;
+}
+
+ReplicationRunner::ReplicationRunner(int s, int l, double s_t, double q, EventSetType e_s,
+                                     int k, BalanceStrategy b, const MLFQParameters& m)
+{
+    schedule = s;
+    lambda = l;
+    inverse_mu = s_t;
+    quantum = q;
+    event_set = e_s;
+    cpus = k;
+    balance = b;
+    mlfq = m;
+    job_limit = 10000;
+    lindley = false;
+    antithetic = false;
+}
+
+ReplicationSummary ReplicationRunner::run(const std::vector<unsigned long>& seeds, unsigned threads) const
+{
+    ReplicationSummary summary;
+    std::size_t per_seed = antithetic ? 2 : 1; // run r is of seed r / per_seed, antithetic when odd
+    summary.runs.resize(seeds.size() * per_seed);
+    summary.antithetic = antithetic;
+
+    // runs claimed at a time: one simulator's, or all the lanes of a LindleyEngine
+    std::size_t claim = lindley && schedule == 1 && cpus == 1 ? LindleyEngine::lanes : 1,
+                claims = (summary.runs.size() + claim - 1) / claim;
+    std::atomic<std::size_t> next(0); // next claim to take
+
+    // each worker takes claims one at a time and writes only its own result slots
+    auto worker = [&]()
+    {
+        for (std::size_t c = next++; c < claims; c = next++)
+        {
+            std::size_t first = c * claim,
+                        last = std::min(summary.runs.size(), first + claim);
+
+            if (claim == 1)
+            {
+                Simulator sim(schedule, lambda, inverse_mu, quantum, event_set, seeds[first / per_seed], cpus, balance, NULL, job_limit,
+                              mlfq, first % per_seed != 0);
+                summary.runs[first] = sim.run();
+                continue;
+            }
+
+            LindleyEngine engine(job_limit);
+            for (std::size_t r = first; r < last; ++r) engine.add(LindleyRun(lambda, inverse_mu, seeds[r / per_seed], r % per_seed != 0));
+
+            std::vector<SimulationResults> results = engine.run();
+            std::copy(results.begin(), results.end(), summary.runs.begin() + first);
+        }
+    };
+
+    if (threads < 1) threads = 1;
+    if (threads > claims) threads = static_cast<unsigned>(claims);
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.push_back(std::thread(worker));
+
+    worker(); // the calling thread works too
+    for (std::size_t t = 0; t < pool.size(); ++t) pool[t].join();
+
+    summary.turnaround_time = confidenceInterval(samples(summary, &SimulationResults::turnaround_time));
+    summary.processes_in_queue = confidenceInterval(samples(summary, &SimulationResults::processes_in_queue));
+    summary.cpu_usage = confidenceInterval(samples(summary, &SimulationResults::cpu_usage));
+    summary.throughput = confidenceInterval(samples(summary, &SimulationResults::throughput));
+
+    return summary;
+}
@@ -0,0 +1,76 @@
+#ifndef REPLICATION_RUNNER_H
+#define REPLICATION_RUNNER_H
+
+#include <vector>      // for seeds and per-replication results
+#include "EventSet.h"
+#include "BalanceStrategy.h"
+#include "SimulationResults.h"
+#include "ConfidenceInterval.h"
+#include "MLFQPolicy.h"
+
+// Aggregate of independent replications of one configuration
+struct ReplicationSummary
+{
+    std::vector<SimulationResults> runs; // one entry per seed, in seed order (antithetic: two per seed, U first)
+    bool antithetic;                     // each seed ran on U and on 1 - U; the pair's mean is one sample
+    ConfidenceInterval turnaround_time,
+                       processes_in_queue,
+                       cpu_usage,
+                       throughput;
+
+    ReplicationSummary() : antithetic(false) {}
+};
+
+// Interval for the mean per-seed difference of two summaries over the same seeds. Every
+// scheduler sees the same jobs for a seed (common random numbers), so the noise of the
+// workload cancels in each difference instead of adding up across two independent sets.
+struct PairedDifference
+{
+    ConfidenceInterval turnaround_time,
+                       processes_in_queue,
+                       cpu_usage,
+                       throughput;
+};
+
+// other - base, for summaries run over the same seeds with the same antithetic setting
+PairedDifference pairedDifference(const ReplicationSummary& base, const ReplicationSummary& other);
+
+// Runs one Simulator per seed across a pool of threads. Each replication owns its
+// generator, and results are gathered in seed order, so the summary is the same for
+// any number of threads.
+class ReplicationRunner
+{
+public:
+    // Constructor
+    ReplicationRunner(int, int, double, double, EventSetType = indexed_heap,
+                      int = 1, BalanceStrategy = global_queue, const MLFQParameters& = MLFQParameters());
+
+    ReplicationSummary run(const std::vector<unsigned long>& seeds, unsigned threads) const;
+
+    void setJobLimit(unsigned long jobs) { job_limit = jobs; } // completions per replication (default 10000)
+
+    // First Come First Serve on one cpu: run the replications LindleyEngine::lanes at a
+    // time through the Lindley recursion. Tq, W, Rho and throughput are unchanged; the
+    // runs carry no distributions or time averages.
+    void setLindley(bool on) { lindley = on; }
+
+    // Antithetic variates: run every seed twice, on its uniforms U and on 1 - U, and
+    // count the pair's mean as one sample. Congestion rises with long services and short
+    // gaps, so the two halves of a pair err in opposite directions.
+    void setAntithetic(bool on) { antithetic = on; }
+
+private:
+    int schedule,          // type of schedule to simulate
+        lambda;            // average arrival rate
+    double inverse_mu,     // average service time
+           quantum;        // time interval length for RR schedule
+    EventSetType event_set;
+    int cpus;              // cores simulated per replication
+    BalanceStrategy balance;
+    MLFQParameters mlfq;   // levels for scheduler 5 (empty: the Simulator default)
+    unsigned long job_limit; // completions each replication runs to
+    bool lindley;          // FCFS replications go through LindleyEngine (see setLindley)
+    bool antithetic;       // each seed also runs on 1 - U (see setAntithetic)
+};
+
+#endif // REPLICATION_RUNNER_H
@@ -0,0 +1,177 @@
+#include <algorithm>   // for min, sort
+#include <cfloat>      // for DBL_EPSILON
+#include <cmath>       // for fabs
+#include <limits>      // for infinity
+#include "ResponseRatioIndex.h"
+
+namespace
+{
+    const double never = std::numeric_limits<double>::infinity();
+    const double error_margin = 16.0 * DBL_EPSILON; // generous bound on rounding in a ratio and a crossing time
+}
+
+ResponseRatioIndex::ResponseRatioIndex()
+{
+    leaves = 0;
+    count = 0;
+    inserted = 0;
+    now = 0.0;
+
+    grow();
+}
+
+double ResponseRatioIndex::ratio(int leaf, double t) const
+{
+    return ((t - arrival[leaf]) + service[leaf]) / service[leaf]; // (Tw + Ts) / Ts
+}
+
+int ResponseRatioIndex::winner(int a, int b, double t) const
+{
+    double ra = ratio(a, t),
+           rb = ratio(b, t);
+
+    if (ra > rb) return a;
+    if (rb > ra) return b;
+
+    return order[a] < order[b] ? a : b; // the scan keeps the first of equal ratios
+}
+
+double ResponseRatioIndex::checkTime(int w, int l, double t) const
+{
+    double sw = service[w],
+           sl = service[l];
+
+    // same slope: the rounded ratios keep their order forever
+    if (sw == sl) return never;
+
+    double slope_w = 1.0 / sw,
+           slope_l = 1.0 / sl,
+           closing = slope_l - slope_w,                          // rate the loser gains on the winner
+           crossing = t + (ratio(w, t) - ratio(l, t)) / closing, // time the lines meet
+
+           // rounding can flip the comparison within this distance of the crossing
+           window = error_margin * ((std::fabs(crossing - arrival[w]) / sw + 1.0)
+                                  + (std::fabs(crossing - arrival[l]) / sl + 1.0)
+                                  + std::fabs(crossing - t) * (slope_w + slope_l))
+                    / std::fabs(closing);
+
+    if (closing > 0) return crossing - window;   // loser is catching up: recheck before it may overtake
+    if (t <= crossing + window) return t;        // lines just crossed: recheck on every advance until clear
+    return never;                                // winner is pulling away for good
+}
+
+void ResponseRatioIndex::update(std::size_t node)
+{
+    int a = best[2 * node],
+        b = best[2 * node + 1];
+
+    if (a < 0 || b < 0)
+    {
+        best[node] = a < 0 ? b : a;
+        check[node] = never;
+    }
+    else
+    {
+        int w = winner(a, b, now);
+
+        best[node] = w;
+        check[node] = checkTime(w, w == a ? b : a, now);
+    }
+
+    subtree_check[node] = std::min(check[node], std::min(subtree_check[2 * node], subtree_check[2 * node + 1]));
+}
+
+void ResponseRatioIndex::updatePath(std::size_t leaf)
+{
+    for (std::size_t node = (leaves + leaf) / 2; node > 0; node /= 2)
+        update(node);
+}
+
+void ResponseRatioIndex::advance(std::size_t node, double t)
+{
+    if (node >= leaves || subtree_check[node] > t) return; // nothing below this node can have changed
+
+    advance(2 * node, t);
+    advance(2 * node + 1, t);
+    update(node);
+}
+
+void ResponseRatioIndex::push(ProcessId p, double a_t, double s_t)
+{
+    if (free_leaves.empty()) grow();
+
+    int leaf = free_leaves.back();
+    free_leaves.pop_back();
+
+    jobs[leaf] = p;
+    arrival[leaf] = a_t;
+    service[leaf] = s_t;
+    order[leaf] = inserted++;
+    best[leaves + leaf] = leaf;
+    ++count;
+
+    updatePath(leaf);
+}
+
+ProcessId ResponseRatioIndex::popHighest(double clock)
+{
+    now = clock;
+    advance(1, clock);
+
+    int leaf = best[1];
+    ProcessId p = jobs[leaf];
+
+    jobs[leaf] = no_process;
+    best[leaves + leaf] = -1;
+    free_leaves.push_back(leaf);
+    --count;
+
+    updatePath(leaf);
+
+    return p;
+}
+
+ProcessId ResponseRatioIndex::highest(double clock)
+{
+    now = clock;
+    advance(1, clock);
+
+    return jobs[best[1]];
+}
+
+void ResponseRatioIndex::grow()
+{
+    std::size_t old_leaves = leaves;
+    leaves = old_leaves == 0 ? 64 : 2 * old_leaves;
+
+    jobs.resize(leaves, no_process);
+    arrival.resize(leaves, 0.0);
+    service.resize(leaves, 0.0);
+    order.resize(leaves, 0);
+
+    for (std::size_t i = leaves; i > old_leaves; --i)
+        free_leaves.push_back(static_cast<int>(i - 1)); // hand out low leaves first
+
+    // rebuild the tree over the enlarged leaf level
+    best.assign(2 * leaves, -1);
+    check.assign(2 * leaves, never);
+    subtree_check.assign(2 * leaves, never);
+
+    for (std::size_t i = 0; i < old_leaves; ++i)
+        if (jobs[i] != no_process) best[leaves + i] = static_cast<int>(i);
+
+    for (std::size_t node = leaves - 1; node > 0; --node)
+        update(node);
+}
+
+void ResponseRatioIndex::contents(std::vector<ProcessId>& out) const
+{
+    std::vector<std::pair<unsigned long, ProcessId> > waiting;
+
+    for (std::size_t i = 0; i < leaves; ++i)
+        if (jobs[i] != no_process) waiting.push_back(std::make_pair(order[i], jobs[i]));
+
+    std::sort(waiting.begin(), waiting.end());
+
+    for (std::size_t i = 0; i < waiting.size(); ++i) out.push_back(waiting[i].second);
+}
@@ -0,0 +1,58 @@
+#ifndef RESPONSE_RATIO_INDEX_H
+#define RESPONSE_RATIO_INDEX_H
+
+#include <cstddef>     // for size_t
+#include <vector>      // for tournament tree storage
+#include "Process.h"
+
+// Ready queue for HRRN. A waiting process's response ratio (Tw + Ts) / Ts is a line in
+// the clock with slope 1 / Ts, so the index is a kinetic tournament tree: every internal
+// node holds the winner of its two children and the time at which that comparison must
+// next be rechecked. Advancing the clock only revisits nodes whose check time has passed,
+// giving O(log n) insertion and removal and amortized polylogarithmic selection.
+//
+// Comparisons use exactly the expression and tie-break (earliest insertion) of a linear
+// scan, and check times are pulled early by a floating-point error bound, so the selected
+// process is the one the scan would pick. Each leaf keeps its process's arrival and
+// service time, so the tree never reads the process table.
+class ResponseRatioIndex
+{
+public:
+    // Constructor
+    ResponseRatioIndex();
+
+    // Mutators
+    void push(ProcessId p, double a_t, double s_t); // add a waiting process that arrived at a_t and needs s_t
+    ProcessId popHighest(double clock);             // remove and return the process with the highest response ratio at clock
+    ProcessId highest(double clock);                // process popHighest(clock) would return, left in place
+
+    // Accessors
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+    void contents(std::vector<ProcessId>& out) const; // waiting processes in insertion order (pushing them back rebuilds an equivalent index)
+
+private:
+    double ratio(int leaf, double t) const;              // (Tw + Ts) / Ts of the process in leaf at time t
+    int winner(int a, int b, double t) const;            // leaf that the linear scan would prefer at time t
+    double checkTime(int w, int l, double t) const;      // when the comparison of w over l must be redone
+    void update(std::size_t node);                       // recompute one internal node at the current time
+    void updatePath(std::size_t leaf);                   // recompute every node above a leaf
+    void advance(std::size_t node, double t);            // revalidate nodes whose check time has passed
+    void grow();                                         // double the number of leaves
+
+    std::vector<ProcessId> jobs;          // process in each leaf (no_process if free)
+    std::vector<double> arrival,          // its arrival time
+                        service;          // and service time
+    std::vector<unsigned long> order;     // insertion number of each leaf, used to break ties
+    std::vector<int> free_leaves;         // unused leaves
+    std::vector<int> best;                // winning leaf of each tree node (-1 if subtree is empty), root at 1
+    std::vector<double> check,            // recheck time of each internal node's own comparison
+                        subtree_check;    // earliest check time in each node's subtree
+
+    std::size_t leaves,                   // capacity, a power of two
+                count;                    // waiting processes
+    unsigned long inserted;               // insertions so far
+    double now;                           // time the tree is currently valid at
+};
+
+#endif // RESPONSE_RATIO_INDEX_H
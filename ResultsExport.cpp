@@ -0,0 +1,140 @@
+#include <limits>      // for max_digits10
+#include "ResultsExport.h"
+
+namespace
+{
+    void writeLatency(std::ostream& out, const LatencySummary& l)
+    {
+        out << "{\"mean\": " << l.mean << ", \"p50\": " << l.p50 << ", \"p95\": " << l.p95
+            << ", \"p99\": " << l.p99 << ", \"p99.9\": " << l.p999 << ", \"max\": " << l.max << "}";
+    }
+
+    void writeInterval(std::ostream& out, const ConfidenceInterval& ci)
+    {
+        out << "{\"mean\": " << ci.mean << ", \"half_width\": " << ci.half_width << "}";
+    }
+
+    // the four intervals of a summary or a paired difference, as members on one line
+    template <class Intervals>
+    void writeIntervals(std::ostream& out, const Intervals& s)
+    {
+        out << "\"Tq\": ";
+        writeInterval(out, s.turnaround_time);
+        out << ", \"W\": ";
+        writeInterval(out, s.processes_in_queue);
+        out << ", \"Rho\": ";
+        writeInterval(out, s.cpu_usage);
+        out << ", \"throughput\": ";
+        writeInterval(out, s.throughput);
+    }
+
+    void writeResults(std::ostream& out, const SimulationResults& r, const char* indent)
+    {
+        out << "{\n"
+            << indent << "  \"Tq\": " << r.turnaround_time << ",\n"
+            << indent << "  \"W\": " << r.processes_in_queue << ",\n"
+            << indent << "  \"Rho\": " << r.cpu_usage << ",\n"
+            << indent << "  \"throughput\": " << r.throughput << ",\n";
+
+        if (r.distributions)
+        {
+            out << indent << "  \"turnaround\": ";
+            writeLatency(out, r.turnaround);
+            out << ",\n" << indent << "  \"waiting\": ";
+            writeLatency(out, r.waiting);
+            out << ",\n"
+                << indent << "  \"mean_queue_length\": " << r.mean_queue_length << ",\n"
+                << indent << "  \"busy_fraction\": " << r.busy_fraction << ",\n";
+        }
+
+        out << indent << "  \"jobs\": " << r.jobs;
+
+        if (r.run_length.controlled)
+        {
+            const RunLength& l = r.run_length;
+            out << ",\n" << indent << "  \"run_length\": {\"metric\": \""
+                << (l.metric == metric_waiting ? "wait" : "Tq") << "\", \"warmup_jobs\": " << l.warmup_jobs
+                << ", \"mser_truncation\": " << l.truncation << ", \"batches\": " << l.batches
+                << ", \"batch_size\": " << l.batch_size << ", \"interval\": ";
+            writeInterval(out, l.interval);
+            out << ", \"warmed_up\": " << (l.warmed_up ? "true" : "false")
+                << ", \"converged\": " << (l.converged ? "true" : "false") << "}";
+        }
+
+        if (!r.core_utilization.empty())
+        {
+            out << ",\n" << indent << "  \"migrations\": " << r.migrations << ",\n"
+                << indent << "  \"core_utilization\": [";
+            for (std::size_t i = 0; i < r.core_utilization.size(); ++i)
+                out << (i ? ", " : "") << r.core_utilization[i];
+            out << "]";
+        }
+
+        out << "\n" << indent << "}";
+    }
+}
+
+void writeJson(std::ostream& out, const SimulationResults& r)
+{
+    std::streamsize precision = out.precision(std::numeric_limits<double>::max_digits10);
+
+    writeResults(out, r, "");
+    out << "\n";
+
+    out.precision(precision);
+}
+
+void writeJson(std::ostream& out, const ReplicationSummary& s)
+{
+    std::streamsize precision = out.precision(std::numeric_limits<double>::max_digits10);
+
+    out << "{\n  \"replications\": " << s.runs.size() << ",\n";
+    if (s.antithetic) out << "  \"antithetic\": true,\n";
+    out << "  \"Tq\": ";
+    writeInterval(out, s.turnaround_time);
+    out << ",\n  \"W\": ";
+    writeInterval(out, s.processes_in_queue);
+    out << ",\n  \"Rho\": ";
+    writeInterval(out, s.cpu_usage);
+    out << ",\n  \"throughput\": ";
+    writeInterval(out, s.throughput);
+    out << ",\n  \"runs\": [";
+
+    for (std::size_t i = 0; i < s.runs.size(); ++i)
+    {
+        out << (i ? ",\n    " : "\n    ");
+        writeResults(out, s.runs[i], "    ");
+    }
+
+    out << "\n  ]\n}\n";
+
+    out.precision(precision);
+}
+
+void writeJson(std::ostream& out, const std::vector<int>& schedules, const std::vector<ReplicationSummary>& s)
+{
+    std::streamsize precision = out.precision(std::numeric_limits<double>::max_digits10);
+
+    out << "{\n  \"replications\": " << (s.empty() ? 0 : s[0].runs.size()) << ",\n"
+        << "  \"antithetic\": " << (!s.empty() && s[0].antithetic ? "true" : "false") << ",\n"
+        << "  \"schedulers\": [";
+
+    for (std::size_t i = 0; i < s.size(); ++i)
+    {
+        out << (i ? ",\n    " : "\n    ") << "{\"scheduler\": " << schedules[i] << ", ";
+        writeIntervals(out, s[i]);
+
+        if (i > 0)
+        {
+            out << ",\n     \"difference\": {"; // this scheduler minus the first, seed by seed
+            writeIntervals(out, pairedDifference(s[0], s[i]));
+            out << "}";
+        }
+
+        out << "}";
+    }
+
+    out << "\n  ]\n}\n";
+
+    out.precision(precision);
+}
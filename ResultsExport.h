@@ -0,0 +1,17 @@
+#ifndef RESULTS_EXPORT_H
+#define RESULTS_EXPORT_H
+
+#include <ostream>     // for output streams
+#include <vector>      // for compared schedulers
+#include "SimulationResults.h"
+#include "ReplicationRunner.h"
+
+// Machine-readable (JSON) form of a run's metrics, written with full double precision
+void writeJson(std::ostream&, const SimulationResults&);
+void writeJson(std::ostream&, const ReplicationSummary&);
+
+// replications of several schedulers over the same seeds: each one's intervals and,
+// after the first, the paired difference from the first
+void writeJson(std::ostream&, const std::vector<int>& schedules, const std::vector<ReplicationSummary>&);
+
+#endif // RESULTS_EXPORT_H
@@ -0,0 +1,185 @@
+#include <algorithm>   // for min, max
+#include <cmath>       // for fabs
+#include "RunLength.h"
+#include "SimulationCore.h"
+
+namespace
+{
+    const std::size_t mser_batch = 5;       // MSER-5: truncate in whole batches of five jobs
+    const std::size_t mser_minimum = 10;    // batches needed before a truncation point is trusted
+    const std::size_t stopping_batches = 32; // batches behind the confidence interval
+    const double independence = 0.2;        // largest lag-1 correlation of batch means taken as independent
+
+    // the five-job warm-up series merged pairwise, as BatchMeans would have, down to fewer
+    // than 2 x stopping_batches batches, for an interval over a run that never warmed up
+    std::vector<double> merged(std::vector<double> means, unsigned long& batch_size)
+    {
+        while (means.size() >= 2 * stopping_batches)
+        {
+            for (std::size_t i = 0; i < means.size() / 2; ++i) means[i] = 0.5 * (means[2 * i] + means[2 * i + 1]);
+            means.resize(means.size() / 2); // an odd last batch is dropped, as in BatchMeans
+            batch_size *= 2;
+        }
+        return means;
+    }
+}
+
+BatchMeans::BatchMeans(RunMetric m, std::size_t batches, std::size_t size) : metric(m)
+{
+    restart(batches, size);
+}
+
+void BatchMeans::restart(std::size_t batches, std::size_t size)
+{
+    limit = 2 * batches;
+    batch_size = size;
+    filled = 0;
+    sum = 0.0;
+    batch.clear();
+    batch.reserve(limit);
+}
+
+void BatchMeans::close()
+{
+    batch.push_back(sum / batch_size);
+    sum = 0.0;
+    filled = 0;
+
+    if (limit == 0 || batch.size() < limit) return;
+
+    for (std::size_t i = 0; i < limit / 2; ++i) batch[i] = 0.5 * (batch[2 * i] + batch[2 * i + 1]);
+    batch.resize(limit / 2);
+    batch_size *= 2;
+}
+
+std::size_t mserTruncation(const std::vector<double>& means)
+{
+    std::size_t n = means.size();
+    if (n < 2) return 0;
+
+    // suffix sums give the mean and spread of means[d..n) for every d in one pass
+    std::vector<double> sum(n + 1, 0.0),
+                        squares(n + 1, 0.0);
+    for (std::size_t i = n; i-- > 0;)
+    {
+        sum[i] = sum[i + 1] + means[i];
+        squares[i] = squares[i + 1] + means[i] * means[i];
+    }
+
+    std::size_t best = 0;
+    double best_statistic = 0.0;
+
+    for (std::size_t d = 0; d + 1 < n; ++d)
+    {
+        double k = static_cast<double>(n - d),
+               spread = squares[d] - sum[d] * sum[d] / k, // sum of squared deviations from the mean
+               statistic = spread / (k * k);
+
+        if (d == 0 || statistic < best_statistic)
+        {
+            best = d;
+            best_statistic = statistic;
+        }
+    }
+
+    return best;
+}
+
+double lagOneCorrelation(const std::vector<double>& means)
+{
+    std::size_t n = means.size();
+    if (n < 3) return 0.0;
+
+    double mean = 0.0;
+    for (std::size_t i = 0; i < n; ++i) mean += means[i];
+    mean /= n;
+
+    double variance = 0.0,
+           covariance = 0.0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        variance += (means[i] - mean) * (means[i] - mean);
+        if (i) covariance += (means[i] - mean) * (means[i - 1] - mean);
+    }
+
+    return variance > 0.0 ? covariance / variance : 0.0;
+}
+
+SimulationResults runControlled(SimulationCore& core, const RunLengthOptions& options)
+{
+    SimulationResults r;
+    RunLength length;
+    BatchMeans series(options.metric, 0, mser_batch); // MSER-5's batches never merge
+
+    length.metric = options.metric;
+    length.controlled = true;
+    core.setBatchMeans(&series);
+
+    // warm-up: grow the pilot run until the MSER-5 truncation point falls in its first half
+    unsigned long target = std::max(1UL, std::min(options.pilot, options.max_jobs));
+    for (;;)
+    {
+        core.setJobLimit(target);
+        r = core.run();
+
+        const std::vector<double>& m = series.means();
+        std::size_t d = mserTruncation(m);
+
+        if (m.size() >= mser_minimum && d < m.size() / 2)
+        {
+            length.warmed_up = true;
+            length.truncation = d * mser_batch;
+            break;
+        }
+
+        if (core.completions() < target || target >= options.max_jobs) break; // workload or cap ran out first
+        target = std::min(2 * target, options.max_jobs);
+    }
+
+    // nothing sound to measure, or the cap left no jobs to measure it with: report the
+    // whole run, unconverged
+    if (!length.warmed_up || core.completions() >= options.max_jobs)
+    {
+        length.batch_size = mser_batch;
+        std::vector<double> m = merged(series.means(), length.batch_size);
+        length.interval = confidenceInterval(m);
+        length.batches = m.size();
+        core.setBatchMeans(NULL);
+        r.run_length = length;
+        return r;
+    }
+
+    // discard everything up to the point the warm-up was recognised, so every reported
+    // statistic covers the same stretch of steady state
+    length.warmup_jobs = core.completions();
+    core.resetStatistics();
+    series.restart(stopping_batches, 1);
+
+    // measure for at least as long as the warm-up took, then grow by half until the interval is tight
+    unsigned long budget = options.max_jobs - length.warmup_jobs; // at least one job
+    target = std::min(std::max(options.pilot, length.warmup_jobs), budget);
+    for (;;)
+    {
+        core.setJobLimit(target);
+        r = core.run();
+
+        const std::vector<double>& m = series.means();
+        length.interval = confidenceInterval(m);
+
+        if (m.size() >= stopping_batches && lagOneCorrelation(m) < independence &&
+            length.interval.half_width <= options.precision * std::fabs(length.interval.mean))
+        {
+            length.converged = true;
+            break;
+        }
+
+        if (core.completions() < target || target >= budget) break;
+        target = std::min(target + std::max(1UL, target / 2), budget);
+    }
+
+    length.batch_size = series.batchSize();
+    length.batches = series.means().size();
+    core.setBatchMeans(NULL);
+    r.run_length = length;
+    return r;
+}
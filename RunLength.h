@@ -0,0 +1,90 @@
+#ifndef RUN_LENGTH_H
+#define RUN_LENGTH_H
+
+#include <cstddef>     // for size_t
+#include <vector>      // for batch means
+#include "ConfidenceInterval.h"
+
+class SimulationCore;
+struct SimulationResults;
+
+// Per-job quantity whose mean decides when a controlled run has gone on long enough
+enum RunMetric { metric_turnaround, metric_waiting };
+
+// Batch means of a stream of per-job observations, kept in a bounded array: once
+// 2 x batches batches have filled, neighbours are merged and the batch size doubles,
+// so the count stays between batches and 2 x batches however long the run gets.
+// With batches = 0 the array is unbounded and the batch size never changes.
+class BatchMeans
+{
+public:
+    // Constructor
+    explicit BatchMeans(RunMetric m, std::size_t batches = 32, std::size_t batch_size = 1);
+
+    // one completed job (called by SimulationCore::complete)
+    void record(double turnaround, double wait)
+    {
+        sum += metric == metric_waiting ? wait : turnaround;
+        if (++filled == batch_size) close();
+    }
+
+    void restart(std::size_t batches, std::size_t batch_size); // drop everything recorded so far (batches 0: never merge)
+
+    const std::vector<double>& means() const { return batch; } // completed batches, oldest first
+    std::size_t batchSize() const { return batch_size; }
+
+private:
+    void close();              // append the current batch, merging pairs when the array is full
+
+    RunMetric metric;
+    std::size_t limit,         // merge when this many batches have filled (0: never)
+                batch_size,    // observations per batch
+                filled;        // observations in the current batch
+    double sum;                // of the current batch
+    std::vector<double> batch; // means of completed batches
+};
+
+// MSER truncation point: the number of leading batches whose removal minimizes the
+// standard error of the mean of what remains. A point in the second half of the series
+// means the run is still too short to tell where the warm-up ends.
+std::size_t mserTruncation(const std::vector<double>& means);
+
+// Lag-1 autocorrelation of a series (0 with fewer than three values)
+double lagOneCorrelation(const std::vector<double>& means);
+
+// Automatic run length: detect the warm-up with MSER-5 on a growing pilot run, discard
+// it, then extend the run until the batch-means confidence interval of the metric is
+// within the requested relative half-width (or the job cap is reached). MSER-5 always
+// sees batches of five jobs, one double per five jobs of the pilot; the stopping rule
+// has its own bounded batch means. No more than max_jobs jobs are ever simulated.
+struct RunLengthOptions
+{
+    RunMetric metric;
+    double precision;          // target half-width relative to the mean (e.g. 0.05)
+    unsigned long pilot,       // jobs in the first warm-up check, doubled until MSER settles
+                  max_jobs;    // cap on the jobs simulated, warm-up included
+
+    RunLengthOptions() : metric(metric_turnaround), precision(0.05), pilot(1000), max_jobs(10000000) {}
+};
+
+// How long a controlled run went and what it achieved
+struct RunLength
+{
+    RunMetric metric;
+    bool controlled,           // false for a fixed --jobs run
+         warmed_up,            // MSER found the end of the warm-up before the cap
+         converged;            // precision reached before the cap or the end of the workload
+    unsigned long warmup_jobs, // completions discarded as warm-up
+                  truncation,  // where MSER placed the end of the warm-up (<= warmup_jobs)
+                  batch_size;  // jobs per batch when the run stopped
+    std::size_t batches;
+    ConfidenceInterval interval; // batch-means interval for the metric's mean
+
+    RunLength() : metric(metric_turnaround), controlled(false), warmed_up(false), converged(false),
+                  warmup_jobs(0), truncation(0), batch_size(0), batches(0) {}
+};
+
+// Drive core (not yet run) under the options; results cover the measured jobs only
+SimulationResults runControlled(SimulationCore& core, const RunLengthOptions& options);
+
+#endif // RUN_LENGTH_H
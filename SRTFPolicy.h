@@ -0,0 +1,154 @@
+#ifndef SRTF_POLICY_H
+#define SRTF_POLICY_H
+
+#include <queue>       // for priority_queue
+#include <vector>      // for container adapter vector in priority_queue
+#include "SimulationCore.h"
+
+// Shortest Remaining Time First: an arrival preempts the running process if it needs less time
+struct SRTFPolicy
+{
+    // a waiting process with its remaining time alongside, which does not change while it
+    // waits, so comparisons never leave the heap
+    struct Waiting
+    {
+        double remaining_time;
+        ProcessId p;
+
+        Waiting(double r_t, ProcessId id) : remaining_time(r_t), p(id) {}
+    };
+
+    class SRTFCompare
+    {
+    public:
+        bool operator()(const Waiting& a, const Waiting& b) const
+        {
+            return a.remaining_time > b.remaining_time; // arrange processes according to process with least remaining execution time at front
+        }
+    };
+
+    typedef std::priority_queue<Waiting, std::vector<Waiting>, SRTFCompare> ReadyQueue;
+
+    ReadyQueue ready_q;
+    ProcessId on_cpu;             // id of process on cpu
+    bool cpu_idle;                // use to determine whether cpu is in use
+    EventHandle departure_event;  // pending departure of the process on cpu (rescheduled on preemption)
+
+    SRTFPolicy() : on_cpu(no_process), cpu_idle(true), departure_event(0) {}
+
+    void onArrival(SimulationCore& sim, ProcessId p)
+    {
+        ProcessTable& table = sim.processTable();
+
+        if (cpu_idle)
+        {
+            on_cpu = p;
+            cpu_idle = false; // cpu is executing a process
+            sim.trace(trace_dispatch, p);
+
+            departure_event = sim.scheduleDeparture(table.completion_time[on_cpu], on_cpu);
+        }
+        else // determine whether the current arrival has a shorter remaining time than currently executing process (can preempt process executing)
+        {
+            table.remaining_time[on_cpu] = table.completion_time[on_cpu] - sim.now();
+
+            if (table.remaining_time[p] >= table.remaining_time[on_cpu])
+            {
+                ready_q.push(Waiting(table.remaining_time[p], p)); // current arrival does not preempt currently executing process
+            }
+            else // current arrival has a shorter remaining time to execute and preempts current executing process
+            {
+                ProcessId temp = on_cpu; // remove currently executing process from cpu
+                on_cpu = p;              // assign new process to cpu
+                sim.trace(trace_preempt, temp);
+                sim.trace(trace_dispatch, p);
+
+                // move the cpu's pending departure from the preempted process to the preempting one
+                sim.rescheduleDeparture(departure_event, table.completion_time[on_cpu], on_cpu);
+
+                ready_q.push(Waiting(table.remaining_time[temp], temp));
+            }
+        }
+    }
+
+    void onDeparture(SimulationCore& sim, ProcessId p)
+    {
+        if (on_cpu != p) // preemption reschedules the cpu's departure, so this only happens if an event slipped through
+        {
+            sim.staleEvent();
+            return;
+        }
+
+        ProcessTable& table = sim.processTable();
+
+        sim.addCpuUsage(table.service_time[on_cpu]);
+        sim.complete(on_cpu);
+
+        if (ready_q.empty()) cpu_idle = true; // cpu has no processes to execute if no processes are waiting
+        else
+        {
+            sim.sampleQueue(ready_q.size());  // count the number of processes waiting in ready queue at this process's departure
+            ProcessId top = ready_q.top().p;
+            ready_q.pop();                    // remove the corresponding process from the min heap
+            on_cpu = top;                     // retrieve next process from min heap (process with least amount of remaining time to execute)
+            sim.trace(trace_dispatch, on_cpu);
+
+            table.completion_time[on_cpu] = sim.now() + table.remaining_time[on_cpu];
+            departure_event = sim.scheduleDeparture(table.completion_time[on_cpu], on_cpu);
+        }
+    }
+
+    void onTimeSlice(SimulationCore&, ProcessId) {} // SRTF never slices
+
+    std::size_t waiting() const { return ready_q.size(); }
+    bool idle() const { return cpu_idle; }
+
+    // hand the next waiting process to another core (least remaining time)
+    ProcessId steal(SimulationCore&)
+    {
+        ProcessId p = ready_q.top().p;
+        ready_q.pop();
+        return p;
+    }
+
+    double nextPriority(SimulationCore&) { return ready_q.top().remaining_time; } // lower runs sooner
+
+    static const unsigned int snapshot_tag = 2;
+
+    // snapshot: cpu state with its departure handle, then the queue in priority order
+    void save(SnapshotWriter& w, SnapshotNumbering& numbering) const
+    {
+        ReadyQueue in_order(ready_q); // a copy to walk the heap
+
+        w.put(static_cast<unsigned char>(cpu_idle));
+        w.put(numbering(cpu_idle ? no_process : on_cpu));
+        if (!cpu_idle) w.put(departure_event);
+        w.put(static_cast<unsigned int>(in_order.size()));
+        for (; !in_order.empty(); in_order.pop()) w.put(numbering(in_order.top().p));
+    }
+
+    bool restore(SnapshotReader& r, const RestoreContext& context)
+    {
+        unsigned char idle = 1;
+        unsigned int n = 0;
+
+        r.get(idle);
+        cpu_idle = idle != 0;
+        on_cpu = context.process(r);
+        if (!cpu_idle) departure_event = context.handle(r);
+
+        ready_q = ReadyQueue();
+        r.get(n);
+        for (unsigned int i = 0; i < n && r.good(); ++i)
+        {
+            ProcessId p = context.required(r);
+            if (p == no_process) break;
+
+            ready_q.push(Waiting(context.table->remaining_time[p], p));
+        }
+
+        return r.good() && (cpu_idle || on_cpu != no_process);
+    }
+};
+
+#endif // SRTF_POLICY_H
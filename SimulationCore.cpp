@@ -0,0 +1,312 @@
+#include <algorithm>   // for stable_sort
+#include <climits>     // for ULONG_MAX
+#include <cmath>       // for HUGE_VAL
+#include "SimulationCore.h"
+
+SimulationCore::SimulationCore(JobSource* s, EventSetType e_s, unsigned long jobs)
+{
+    event_q = EventSet::create(e_s); // future-event set backend (binary heap or calendar queue)
+    source = s;                // where arrivals come from
+    end_condition = jobs ? jobs : ULONG_MAX; // run until this many processes have been executed (0: until the workload drains)
+    processes = 0;             // initialize amount of processes executed
+    clock = 0.0;               // start clock at time 0
+    stats_start = 0.0;         // measure from the start
+    cpu_usage = 0.0;           // initialize to accumulate service times of the processes
+    turnaround_time = 0.0;     // initialize to accumulate turnaround time of the processes
+    processes_in_queue = 0.0;  // initialize to accumulate every time an event occurs
+    cancelled_events = 0;      // count departures withdrawn on preemption
+    stale_events = 0;          // count departures that fire for a process no longer on cpu
+    events_processed = 0;      // count events handled by the loop
+    peak_pending = 0;          // deepest future-event set so far
+    peak_waiting = 0;          // longest ready queue so far
+    waiting_level = 0;         // nothing waiting at the start
+    arrivals = 0;              // number processes from 0
+    tracer = NULL;             // tracing is opt-in
+    batch_means = NULL;        // fixed run length unless a controller attaches
+    fast_forward = true;       // let policies skip events that cannot change anything (one cpu only)
+    next_arrival = HUGE_VAL;   // set by the first arrival below
+
+    scheduleArrival();         // initialize event queue with the first arrival
+}
+
+SimulationCore::~SimulationCore()
+{
+    delete event_q;
+    delete source;
+}
+
+void SimulationCore::scheduleArrival()
+{
+    double arrival_time,
+           service_time;
+
+    if (!source->next(arrival_time, service_time)) // workload exhausted: the run drains what is left
+    {
+        next_arrival = HUGE_VAL;
+        return;
+    }
+
+    ProcessId new_p = table.acquire(service_time, arrival_time);
+    table.sequence[new_p] = arrivals++;
+
+    event_q->push(Event(arrival_time, arrival, new_p));
+    next_arrival = arrival_time;
+}
+
+SimulationResults SimulationCore::results()
+{
+    SimulationResults r;
+
+    if (processes == 0) return r; // empty workload
+
+    r.turnaround_time = turnaround_time / processes;       // calculate avg. turnaround time as sum(turnaround) / processes executed
+    r.processes_in_queue = processes_in_queue / processes; // calculate avg. processes waiting in ready queue as processes_in_queue / total process
+    r.cpu_usage = cpu_usage / elapsed();                   // calculate CPU utilization as sum(service_time) / completion time of last process
+    r.throughput = processes / elapsed();                  // calculate throughput as processes / completion time of last process
+    r.jobs = processes;
+
+    r.turnaround = turnaround_sketch.summary();
+    r.waiting = waiting_sketch.summary();
+    r.mean_queue_length = queue_length.mean(clock);
+    r.busy_fraction = busy_cpus.mean(clock);
+
+    return r;
+}
+
+void SimulationCore::setJobLimit(unsigned long jobs)
+{
+    end_condition = jobs ? jobs : ULONG_MAX;
+}
+
+void SimulationCore::resetStatistics()
+{
+    processes = 0;
+    cpu_usage = 0.0;
+    turnaround_time = 0.0;
+    processes_in_queue = 0.0;
+    turnaround_sketch.clear();
+    waiting_sketch.clear();
+    queue_length.restart(clock);
+    busy_cpus.restart(clock);
+    stats_start = clock;
+}
+
+namespace
+{
+    const char snapshot_magic[8] = { 'C', 'P', 'U', 'S', 'N', 'A', 'P', '\0' };
+    const unsigned int snapshot_version = 4;
+
+    bool earlier(const PendingEvent& a, const PendingEvent& b) { return a.e.time < b.e.time; }
+}
+
+std::string SimulationCore::snapshot() const
+{
+    SnapshotWriter w, body;
+    SnapshotNumbering numbering;
+
+    // events and policy state go first into their own buffer, numbering the processes they mention
+    std::vector<PendingEvent> events;
+    event_q->pending(events);
+
+    body.put(static_cast<unsigned int>(events.size()));
+    for (std::size_t i = 0; i < events.size(); ++i)
+    {
+        body.put(events[i].e.time);
+        body.put(static_cast<unsigned char>(events[i].e.type));
+        body.put(numbering(events[i].e.p));
+        body.put(events[i].h);
+    }
+
+    savePolicy(body, numbering);
+
+    for (std::size_t i = 0; i < sizeof(snapshot_magic); ++i) w.put(snapshot_magic[i]);
+    w.put(snapshot_version);
+    w.put(policyTag());
+    w.put(cpuCount());
+
+    w.put(clock);
+    w.put(stats_start);
+    w.put(cpu_usage);
+    w.put(turnaround_time);
+    w.put(processes_in_queue);
+    w.put(static_cast<unsigned long long>(processes));
+    w.put(static_cast<unsigned long long>(end_condition));
+    w.put(static_cast<unsigned long long>(cancelled_events));
+    w.put(static_cast<unsigned long long>(stale_events));
+    w.put(events_processed);
+    w.put(static_cast<unsigned long long>(peak_pending));
+    w.put(static_cast<unsigned long long>(peak_waiting));
+    w.put(static_cast<unsigned long long>(waiting_level));
+    w.put(static_cast<unsigned long long>(table.peakLive()));
+    w.put(arrivals);
+
+    source->save(w);
+    turnaround_sketch.save(w);
+    waiting_sketch.save(w);
+    queue_length.save(w);
+    busy_cpus.save(w);
+
+    const std::vector<ProcessId>& processes_in_system = numbering.processes();
+    w.put(static_cast<unsigned int>(processes_in_system.size()));
+    for (std::size_t i = 0; i < processes_in_system.size(); ++i)
+    {
+        ProcessId p = processes_in_system[i];
+        w.put(table.service_time[p]);
+        w.put(table.arrival_time[p]);
+        w.put(table.remaining_time[p]);
+        w.put(table.completion_time[p]);
+        w.put(table.cpu[p]);
+        w.put(table.sequence[p]);
+        w.put(table.level[p]);
+    }
+
+    w.append(body);
+
+    return w.data();
+}
+
+bool SimulationCore::restore(const std::string& snapshot, std::string& error)
+{
+    if (events_processed != 0)
+    {
+        error = "a snapshot can only be restored before the simulation runs";
+        return false;
+    }
+
+    SnapshotReader r(snapshot);
+    char magic[sizeof(snapshot_magic)];
+    unsigned int version = 0, tag = 0, cpus = 0;
+
+    for (std::size_t i = 0; i < sizeof(magic); ++i) r.get(magic[i]);
+    r.get(version);
+    r.get(tag);
+    r.get(cpus);
+
+    if (!r.good() || std::string(magic, sizeof(magic)) != std::string(snapshot_magic, sizeof(snapshot_magic)))
+    {
+        error = "not a simulator snapshot";
+        return false;
+    }
+    if (version != snapshot_version)
+    {
+        error = "unsupported snapshot version";
+        return false;
+    }
+    if (tag != policyTag() || cpus != cpuCount())
+    {
+        error = "snapshot was taken with a different scheduler or cpu count";
+        return false;
+    }
+
+    unsigned long long n_processes = 0, limit = 0, cancelled = 0, stale = 0;
+    unsigned long long pending_peak = 0, waiting_peak = 0, level = 0, live_peak = 0;
+
+    r.get(clock);
+    r.get(stats_start);
+    r.get(cpu_usage);
+    r.get(turnaround_time);
+    r.get(processes_in_queue);
+    r.get(n_processes);
+    r.get(limit);
+    r.get(cancelled);
+    r.get(stale);
+    r.get(events_processed);
+    r.get(pending_peak);
+    r.get(waiting_peak);
+    r.get(level);
+    r.get(live_peak);
+    r.get(arrivals);
+
+    processes = static_cast<unsigned long>(n_processes);
+    end_condition = static_cast<unsigned long>(limit);
+    cancelled_events = static_cast<unsigned long>(cancelled);
+    stale_events = static_cast<unsigned long>(stale);
+    peak_pending = static_cast<std::size_t>(pending_peak);
+    peak_waiting = static_cast<std::size_t>(waiting_peak);
+    waiting_level = static_cast<std::size_t>(level);
+
+    if (!source->restore(r))
+    {
+        error = "snapshot does not match this workload";
+        return false;
+    }
+
+    turnaround_sketch.restore(r);
+    waiting_sketch.restore(r);
+    queue_length.restore(r);
+    busy_cpus.restore(r);
+
+    // drop the first arrival the constructor scheduled
+    std::vector<PendingEvent> initial;
+    event_q->pending(initial);
+    for (std::size_t i = 0; i < initial.size(); ++i)
+    {
+        event_q->cancel(initial[i].h);
+        table.release(initial[i].e.p);
+    }
+
+    RestoreContext context;
+    context.table = &table;
+    unsigned int count = 0;
+
+    r.get(count);
+    for (unsigned int i = 0; i < count && r.good(); ++i)
+    {
+        double s_t = 0, a_t = 0, r_t = 0, c_t = 0;
+        r.get(s_t);
+        r.get(a_t);
+        r.get(r_t);
+        r.get(c_t);
+
+        ProcessId p = table.acquire(s_t, a_t);
+        table.remaining_time[p] = r_t;
+        table.completion_time[p] = c_t;
+        r.get(table.cpu[p]);
+        r.get(table.sequence[p]);
+        r.get(table.level[p]);
+        context.processes.push_back(p);
+    }
+
+    std::vector<PendingEvent> events;
+
+    r.get(count);
+    for (unsigned int i = 0; i < count && r.good(); ++i)
+    {
+        double time = 0;
+        unsigned char type = 0;
+        EventHandle h = 0;
+
+        r.get(time);
+        r.get(type);
+        ProcessId p = context.process(r);
+        r.get(h);
+
+        if (type > time_slice || p == no_process) r.fail();
+        else events.push_back(PendingEvent(Event(time, static_cast<EventType>(type), p), h));
+    }
+
+    std::stable_sort(events.begin(), events.end(), earlier); // push in time order, so equal times keep a fixed order
+    next_arrival = HUGE_VAL;
+    for (std::size_t i = 0; i < events.size(); ++i)
+    {
+        context.handles[events[i].h] = event_q->push(events[i].e);
+        if (events[i].e.type == arrival && events[i].e.time < next_arrival) next_arrival = events[i].e.time;
+    }
+
+    bool fits = restorePolicy(r, context);
+    table.restoreHighWater(static_cast<std::size_t>(live_peak));
+
+    if (!r.good() || !r.atEnd())
+    {
+        error = "snapshot is truncated or corrupt";
+        return false;
+    }
+    if (!fits)
+    {
+        error = "the scheduler's state does not fit this configuration (Round Robin slices fast-forwarded "
+                "at another quantum: take the snapshot with fast-forward off to change it)";
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,180 @@
+#ifndef SIMULATION_CORE_H
+#define SIMULATION_CORE_H
+
+#include <cstddef>     // for size_t
+#include <string>      // for snapshots
+#include "Event.h"
+#include "EventSet.h"
+#include "Process.h"
+#include "ProcessTable.h"
+#include "SimulationResults.h"
+#include "StreamingStats.h"
+#include "EventTrace.h"
+#include "Snapshot.h"
+#include "RunLength.h"
+#include "JobSource.h"
+
+// State and services shared by every scheduling discipline: the clock, the future-event
+// set, the process table, the workload source and the accumulators behind the reported
+// metrics. Engine<Policy> drives the event loop; policies call back into the services
+// below, all of which are inline so the instantiated loop has no indirect calls.
+class SimulationCore
+{
+public:
+    // Constructor: takes ownership of the source; runs until jobs processes complete
+    // (0: until the source is exhausted)
+    SimulationCore(JobSource*, EventSetType, unsigned long jobs = 10000);
+    // Destructor
+    virtual ~SimulationCore();
+
+    virtual SimulationResults run() = 0; // run the simulation to completion and return its metrics
+
+    // Snapshots capture the whole run: clock, accumulators, workload position and random
+    // streams, pending events, processes and the policy's queues. A snapshot restores only
+    // into a core that has not run yet and was built with the same scheduler, cpu count
+    // and workload source; the event set backend may differ. A failed restore leaves the
+    // core unusable.
+    std::string snapshot() const;
+    bool restore(const std::string& snapshot, std::string& error);
+
+    void setJobLimit(unsigned long jobs);  // completions to stop at (0: until the workload drains); run() may be called again to continue
+    virtual void resetStatistics();        // measure from now on: clears the accumulators, keeps the system state
+
+    // Services for scheduling policies
+    double now() const { return clock; }
+
+    EventHandle scheduleDeparture(double time, ProcessId p) { return event_q->push(Event(time, departure, p)); }
+    EventHandle scheduleTimeSlice(double time, ProcessId p) { return event_q->push(Event(time, time_slice, p)); }
+
+    // move a pending departure to another process and time (preemption), counting the withdrawn one
+    void rescheduleDeparture(EventHandle h, double time, ProcessId p)
+    {
+        event_q->reschedule(h, Event(time, departure, p));
+        ++cancelled_events;
+    }
+
+    // the same, turning the pending event into the end of a time slice
+    void rescheduleTimeSlice(EventHandle h, double time, ProcessId p)
+    {
+        event_q->reschedule(h, Event(time, time_slice, p));
+        ++cancelled_events;
+    }
+
+    void addCpuUsage(double t) { cpu_usage += t; }                          // cpu time committed to a process
+    void sampleQueue(std::size_t waiting) { processes_in_queue += waiting; } // ready-queue length seen at a departure
+    void staleEvent() { ++stale_events; }                                    // an event fired that no longer applied
+
+    // append p's event to the timeline, if one is being recorded (a single test otherwise)
+    void trace(TraceKind kind, ProcessId p)
+    {
+        if (tracer) tracer->record(clock, kind, table.sequence[p], table.cpu[p], waiting_level);
+    }
+
+    void setTracer(EventTracer* t) { tracer = t; } // not owned; NULL turns tracing off
+    void setBatchMeans(BatchMeans* b) { batch_means = b; } // not owned; receives every completion, NULL for none
+
+    // Policies may play out stretches of events that cannot affect anything but their own
+    // cpu (Round Robin's slices before the next arrival) without pushing them. Only sound
+    // with one cpu, so MultiCoreEngine turns it off; recording a timeline turns it off too.
+    void setFastForward(bool on) { fast_forward = on; }
+    bool fastForward() const { return fast_forward && !tracer; }
+    double nextArrival() const { return next_arrival; } // time of the pending arrival (HUGE_VAL once the workload is exhausted)
+
+    // a process has finished (called at its departure): accumulate its turnaround time and recycle its slot
+    void complete(ProcessId p)
+    {
+        double response = clock - table.arrival_time[p],
+               wait = response - table.service_time[p];
+        if (wait <= 1e-9 * response) wait = 0.0; // drop rounding residue left by preemption bookkeeping
+        turnaround_sketch.record(response);
+        waiting_sketch.record(wait);
+        if (batch_means) batch_means->record(response, wait);
+
+        turnaround_time += table.completion_time[p] - table.arrival_time[p]; // accumulate completion times (complete - arrival)
+        ++processes;                                                       // count the number of processes that have been executed
+        table.release(p);
+    }
+
+    // Accessors
+    unsigned long completions() const { return processes; }  // since the statistics were last reset
+    unsigned long cancelledEvents() const { return cancelled_events; }
+    unsigned long staleEvents() const { return stale_events; }
+    unsigned long long eventsProcessed() const { return events_processed; }
+    std::size_t peakPendingEvents() const { return peak_pending; } // deepest the future-event set got
+    std::size_t peakWaiting() const { return peak_waiting; }       // longest the ready queues got (summed over cpus)
+    ProcessTable& processTable() { return table; } // columns of every process in the system
+    const ProcessTable& processTable() const { return table; }
+
+protected:
+    // snapshot hooks for the event loop's policy state
+    virtual unsigned int policyTag() const = 0;   // which discipline, so a snapshot cannot restore into another
+    virtual unsigned int cpuCount() const = 0;
+    virtual void savePolicy(SnapshotWriter& w, SnapshotNumbering& numbering) const = 0;
+    virtual bool restorePolicy(SnapshotReader& r, const RestoreContext& context) = 0;
+
+    double elapsed() const { return clock - stats_start; } // simulated time covered by the statistics
+
+    bool finished() const { return processes == end_condition || event_q->empty(); }
+    double cpuTime() const { return cpu_usage; } // cpu time committed so far (across all cores)
+
+    // remove the earliest event and advance the clock to it
+    Event nextEvent()
+    {
+        std::size_t pending = event_q->size();
+        if (pending > peak_pending) peak_pending = pending;
+        ++events_processed;
+
+        Event e = event_q->top();  // get first element in event queue
+        event_q->pop();            // remove first element from event queue
+        clock = e.time;            // get time event occurs (arrival arrives, departure departs, time slice is alloted)
+        return e;
+    }
+
+    // ready-queue length and busy cpus in force from now until the next event
+    void observeLevels(std::size_t waiting, std::size_t busy)
+    {
+        if (waiting > peak_waiting) peak_waiting = waiting;
+        waiting_level = waiting;
+        queue_length.set(clock, waiting);
+        busy_cpus.set(clock, busy);
+    }
+
+    void scheduleArrival();        // create the source's next process and its arrival event, if any
+    SimulationResults results();   // turn the accumulators into averages
+
+private:
+    SimulationCore(const SimulationCore&);            // non-copyable: owns its event set
+    SimulationCore& operator=(const SimulationCore&);
+
+    ProcessTable table;        // every process in the system; ids are recycled on departure
+    EventSet* event_q;         // future-event set (backend chosen at construction)
+
+    JobSource* source;         // workload: synthetic streams owned by this instance, or a trace
+
+    unsigned long processes,   // count the amount of processes executed
+                  end_condition; // total number of processes to process (0: all the source supplies)
+    double clock,              // keep time of events
+           stats_start,        // time the statistics were last reset
+           cpu_usage,          // keep track of amount of time cpu is used
+           turnaround_time,    // accumulate process's turnaround time
+           processes_in_queue; // accumulate ready-queue length at each departure
+
+    LatencySketch turnaround_sketch, // turnaround distribution, fixed size
+                  waiting_sketch;    // waiting-time distribution, fixed size
+    TimeAverage queue_length,        // ready-queue length over time
+                busy_cpus;           // cpus in use over time
+
+    unsigned long cancelled_events, // departures withdrawn from the event set before firing
+                  stale_events;     // departures popped after they no longer applied
+    unsigned long long events_processed; // events popped by the loop
+    std::size_t peak_pending,       // largest future-event set seen
+                peak_waiting,       // most processes waiting at once
+                waiting_level;      // processes waiting since the last event
+    unsigned int arrivals;          // processes created, numbers them for traces
+    EventTracer* tracer;            // timeline recorder, NULL when tracing is off
+    BatchMeans* batch_means;        // run-length control's observations, NULL when the length is fixed
+    bool fast_forward;              // policies may skip events (see setFastForward)
+    double next_arrival;            // time of the one pending arrival event
+};
+
+#endif // SIMULATION_CORE_H
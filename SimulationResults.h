@@ -0,0 +1,32 @@
+#ifndef SIMULATION_RESULTS_H
+#define SIMULATION_RESULTS_H
+
+#include <vector>      // for per-core utilization
+#include "StreamingStats.h"
+#include "RunLength.h"
+
+// Summary metrics of one simulation run
+struct SimulationResults
+{
+    double turnaround_time,    // avg. turnaround time (Tq)
+           processes_in_queue, // avg. processes waiting in ready queue at a departure (W)
+           cpu_usage,          // fraction of time the cpu was busy (Rho)
+           throughput;         // processes completed per unit time
+
+    LatencySummary turnaround,    // turnaround (departure - arrival) distribution
+                   waiting;       // time spent in ready queues (turnaround - service time)
+    double mean_queue_length,     // time-weighted avg. processes waiting in ready queues
+           busy_fraction;         // time-weighted fraction of time the cpus were busy
+
+    std::vector<double> core_utilization; // busy fraction of each cpu (multi-core runs only)
+    unsigned long migrations;             // processes moved between cpu ready queues
+
+    unsigned long jobs;                   // processes the metrics cover (warm-up excluded)
+    RunLength run_length;                 // warm-up and stopping decisions of a controlled run
+    bool distributions;                   // turnaround, waiting and the time averages were recorded (not by LindleyEngine)
+
+    SimulationResults() : turnaround_time(0), processes_in_queue(0), cpu_usage(0), throughput(0),
+                          mean_queue_length(0), busy_fraction(0), migrations(0), jobs(0), distributions(true) {}
+};
+
+#endif // SIMULATION_RESULTS_H
@@ -1,81 +1,80 @@
-#ifndef SIMULATOR_H
-#define SIMULATOR_H
-
-#include <queue>       // for stl queue data structures
-#include <vector>      // for container adapter vector in priority_queue
-#include <list>
-#include "Event.h"
-#include "Process.h"
-#include "EventType.h"
-
-class Simulator
-{
-public:
-    // Constructor
-    Simulator(int, int, double, double);
-    // Accessors
-    void simulate(); // engine that runs simulation of CPU scheduling
-
-private:
-    // general schedule of an event (arrival, departure, time_slice)
-    void scheduleEvent(EventType, double, Process* p);
-
-    // CPU Schedule algorithms
-    void scheduleFCFS(const Event& e);
-    void scheduleSRTF(const Event& e);
-    void scheduleHRRN(const Event& e);
-    void scheduleRR(const Event& e);
-
-    // responses to a process' completion depending on the type of cpu schedule in use
-    void departureFCFS(Event& d);
-    void departureSRTF(Event& d);
-    void departureHRRN(Event& d);
-    void departureRR(Event& d);
-
-    // handles time slices for round robin scheduler
-    void handleTimeSlice(Event& t);
-
-    void interArrivalTimeServiceTime(double&, double&); // calculate the inter-arrival time of a process and its service time
-
-    // Functor to equip priority_queue with means for interpreting priority of Event structs
-    class EventCompare
-    {
-    public:
-        bool operator()(Event& a, Event& b)
-        {
-            return a.time > b.time; // arrange events according to earliest event at front
-        }
-    };
-
-    class SRTFCompare
-    {
-    public:
-        bool operator()(Process* a, Process* b)
-        {
-            return a->remaining_time > b->remaining_time; // arrange processes according to process with least remaining execution time at front
-        }
-    };
-
-    std::priority_queue<Event, std::vector<Event>, EventCompare> event_q;
-    std::priority_queue<Process*, std::vector<Process*>, SRTFCompare> ready_q_x;
-    std::queue<Process*> ready_q;
-    std::list<Process*> ready_q_y; // use for HRRN to leverage constant removal of elements when retrieving next waiting process
-
-    int schedule,              // type of schedule to simulate
-        processes,             // count the amount of processes executed
-        end_condition,         // total number of processes to process
-        events;                // ask about whether this is a correct method for calculating avg. waiting processes in ready queue
-    double clock,              // keep time of events
-           cpu_usage,          // keep track of amount of time cpu is used
-           turnaround_time,    // accumulate process's turnaround time
-           throughput,         // processes / unit time
-           processes_in_queue, // update every event
-           lambda,             // average arrival rate
-           inverse_mu,         // average service rate
-           quantum,            // time interval length for RR schedule
-           check_cpu_usage;
-    bool cpu_idle;             // use to determine whether cpu is in use
-
-    Process* on_cpu;           // pointer to process on cpu (maintain in preemptive schedulers)
-};
-#endif // SIMULATOR_H
\ No newline at end of file
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include <string>      // for snapshots and the trace path
+#include <vector>      // for forked continuations
+#include "EventSet.h"
+#include "BalanceStrategy.h"
+#include "SimulationCore.h"
+#include "SimulationResults.h"
+#include "EventTrace.h"
+#include "MLFQPolicy.h"
+
+class TraceReader;
+
+// Runtime front end: picks the Engine (one cpu) or MultiCoreEngine (several cpus)
+// instantiation for the requested scheduler once, at construction, so the event loop
+// itself never switches on the schedule
+class Simulator
+{
+public:
+    // Constructor
+    // (MLFQ levels default to MLFQParameters::standard of the quantum; antithetic draws
+    // the seed's workload from 1 - U in place of every U)
+    Simulator(int, int, double, double, EventSetType = indexed_heap, unsigned long = 1,
+              int = 1, BalanceStrategy = global_queue, const char* = NULL, unsigned long = 10000,
+              const MLFQParameters& = MLFQParameters(), bool = false);
+    // Destructor
+    ~Simulator();
+    // Accessors
+    void simulate();        // engine that runs simulation of CPU scheduling, reporting to stdout and sim.json
+    SimulationResults run(); // run the simulation silently and return its metrics
+    const SimulationCore& core() const { return *engine; } // event and process-table counters of the run
+    bool traceTo(const char* path); // record the run's event timeline (before simulate/run)
+
+    // Snapshots (see SimulationCore): restore and load need a simulator that has not run and
+    // was built with the same scheduler, cpus and workload; the job limit stays this one's
+    std::string snapshot() const;
+    bool restore(const std::string& snapshot, std::string& error);
+    bool save(const char* path, std::string& error) const;
+    bool load(const char* path, std::string& error);
+
+    // clone the current state into one new simulator per quantum (the quantum only matters
+    // for Round Robin); the caller owns the continuations. A Round Robin run only forks to
+    // another quantum if it ran with setFastForward(false) (see RRPolicy::save)
+    bool fork(const std::vector<double>& quanta, std::vector<Simulator*>& continuations, std::string& error) const;
+
+    void resetStatistics();             // measure from the current state on
+    void setJobLimit(unsigned long);    // completions to stop at; run() again to continue
+    void setFastForward(bool);          // skip Round Robin slices that cannot matter (default on; one cpu only)
+
+    // choose the run length automatically (see RunLength.h) instead of a fixed job count
+    void controlRunLength(const RunLengthOptions& options);
+
+private:
+    Simulator(const Simulator&);            // non-copyable: owns its engine
+    Simulator& operator=(const Simulator&);
+
+    void build(); // construct the engine from the arguments below
+
+    // construction arguments, so fork() can build matching simulators
+    int schedule,              // type of schedule to simulate
+        lambda;                // average arrival rate
+    double inverse_mu,         // average service time
+           quantum;            // time interval length for RR schedule
+    EventSetType event_set;
+    unsigned long seed;
+    int cpus;
+    BalanceStrategy balance;
+    std::string trace_path;    // empty for the synthetic workload
+    unsigned long job_limit;
+    MLFQParameters mlfq;       // levels for scheduler 5
+    bool antithetic;           // synthetic workload from 1 - U (the seed's antithetic twin)
+    bool controlled;           // run length chosen by run_length, not job_limit
+    RunLengthOptions run_length;
+
+    SimulationCore* engine;    // Engine<Policy> for the selected scheduler
+    EventTracer* tracer;       // timeline recorder, NULL unless tracing
+    TraceReader* reader;       // the engine's trace workload, NULL for the synthetic one
+};
+#endif // SIMULATOR_H
@@ -0,0 +1,24 @@
+#include <fstream>     // for snapshot files
+#include "Snapshot.h"
+
+bool writeSnapshotFile(const char* path, const std::string& snapshot)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(snapshot.data(), snapshot.size());
+    return static_cast<bool>(out);
+}
+
+bool readSnapshotFile(const char* path, std::string& snapshot)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+
+    in.seekg(0, std::ios::end);
+    std::streamoff size = in.tellg();
+    in.seekg(0, std::ios::beg);
+
+    snapshot.resize(static_cast<std::size_t>(size));
+    if (size > 0) in.read(&snapshot[0], size);
+
+    return static_cast<bool>(in);
+}
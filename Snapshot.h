@@ -0,0 +1,144 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstddef>     // for size_t
+#include <cstring>     // for memcpy
+#include <map>         // for process numbering and handle translation
+#include <string>      // for the byte buffer
+#include <type_traits> // for is_arithmetic, is_enum
+#include <vector>      // for restored processes
+#include "ByteOrder.h"
+#include "EventSet.h"
+#include "Process.h"
+#include "ProcessTable.h"
+
+// Appends fixed-width scalar fields to a byte buffer, little-endian on every host (see
+// ByteOrder.h), so a snapshot saved on one machine loads on any other
+class SnapshotWriter
+{
+public:
+    template <class T>
+    void put(const T& v)
+    {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "snapshots hold scalar fields only");
+        T field = ByteOrder::littleEndian(v);
+        bytes.append(reinterpret_cast<const char*>(&field), sizeof(T));
+    }
+
+    void append(const SnapshotWriter& w) { bytes += w.bytes; }
+
+    const std::string& data() const { return bytes; }
+
+private:
+    std::string bytes;
+};
+
+// Reads fields back in the order they were written. Any read past the end marks the
+// reader failed and leaves the destination unchanged, so callers check good() once.
+class SnapshotReader
+{
+public:
+    // Constructor
+    explicit SnapshotReader(const std::string& b) : bytes(b), offset(0), failed(false) {}
+
+    template <class T>
+    bool get(T& v)
+    {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "snapshots hold scalar fields only");
+        if (failed || bytes.size() - offset < sizeof(T))
+        {
+            failed = true;
+            return false;
+        }
+        std::memcpy(&v, bytes.data() + offset, sizeof(T));
+        v = ByteOrder::littleEndian(v);
+        offset += sizeof(T);
+        return true;
+    }
+
+    void fail() { failed = true; }
+    bool good() const { return !failed; }
+    bool atEnd() const { return offset == bytes.size(); }
+
+private:
+    const std::string& bytes;
+    std::size_t offset;
+    bool failed;
+};
+
+// Numbers the processes a snapshot refers to, in order of first reference; the table is
+// written ahead of everything that uses the numbers
+class SnapshotNumbering
+{
+public:
+    static const unsigned int none = 0xFFFFFFFFu; // reference to no process
+
+    unsigned int operator()(ProcessId p)
+    {
+        if (p == no_process) return none;
+
+        std::map<ProcessId, unsigned int>::iterator i = numbers.find(p);
+        if (i != numbers.end()) return i->second;
+
+        unsigned int n = static_cast<unsigned int>(order.size());
+        numbers[p] = n;
+        order.push_back(p);
+        return n;
+    }
+
+    const std::vector<ProcessId>& processes() const { return order; }
+
+private:
+    std::map<ProcessId, unsigned int> numbers;
+    std::vector<ProcessId> order;
+};
+
+// What a restoring policy needs to turn snapshot references back into live processes
+struct RestoreContext
+{
+    std::vector<ProcessId> processes;           // by snapshot number
+    std::map<EventHandle, EventHandle> handles; // snapshot handle -> handle in the rebuilt event set
+    ProcessTable* table;                        // holds the restored processes
+
+    RestoreContext() : table(NULL) {}
+
+    // process for a stored number, or no_process for none; an unknown number fails the reader
+    ProcessId process(SnapshotReader& r) const
+    {
+        unsigned int n;
+        if (!r.get(n) || n == SnapshotNumbering::none) return no_process;
+        if (n >= processes.size())
+        {
+            r.fail();
+            return no_process;
+        }
+        return processes[n];
+    }
+
+    // as process(), but a reference to no process is an error too
+    ProcessId required(SnapshotReader& r) const
+    {
+        ProcessId p = process(r);
+        if (p == no_process) r.fail();
+        return p;
+    }
+
+    EventHandle handle(SnapshotReader& r) const
+    {
+        EventHandle h;
+        if (!r.get(h)) return 0;
+
+        std::map<EventHandle, EventHandle>::const_iterator i = handles.find(h);
+        if (i == handles.end())
+        {
+            r.fail();
+            return 0;
+        }
+        return i->second;
+    }
+};
+
+bool writeSnapshotFile(const char* path, const std::string& snapshot);
+bool readSnapshotFile(const char* path, std::string& snapshot);
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,120 @@
+#include <cmath>       // for frexp, ldexp, ceil
+#include "StreamingStats.h"
+
+LatencySketch::LatencySketch()
+{
+    clear();
+}
+
+void LatencySketch::clear()
+{
+    for (std::size_t i = 0; i < buckets; ++i) counts[i] = 0;
+    zeros = 0;
+    total = 0;
+    sum = 0.0;
+    largest = 0.0;
+}
+
+std::size_t LatencySketch::bucketOf(double v)
+{
+    int e;
+    double m = std::frexp(v, &e); // v = m * 2^e with m in [0.5, 1)
+
+    if (e <= min_exponent) return 0;
+    if (e > max_exponent) return buckets - 1;
+
+    std::size_t sub = static_cast<std::size_t>((m - 0.5) * (2 * sub_buckets));
+    return static_cast<std::size_t>(e - min_exponent - 1) * sub_buckets + sub;
+}
+
+double LatencySketch::bucketMidpoint(std::size_t i)
+{
+    int e = static_cast<int>(i / sub_buckets) + min_exponent + 1;
+    double sub = static_cast<double>(i % sub_buckets);
+
+    return std::ldexp(0.5 + (sub + 0.5) / (2 * sub_buckets), e);
+}
+
+double LatencySketch::quantile(double q) const
+{
+    if (total == 0) return 0.0;
+
+    double rank = std::ceil(q * total);
+    if (rank < 1) rank = 1;
+
+    unsigned long long seen = zeros;
+    if (seen >= rank) return 0.0;
+
+    for (std::size_t i = 0; i < buckets; ++i)
+    {
+        seen += counts[i];
+        if (seen >= rank)
+        {
+            double v = bucketMidpoint(i);
+            return v < largest ? v : largest; // the top bucket's midpoint can overshoot the exact maximum
+        }
+    }
+
+    return largest;
+}
+
+LatencySummary LatencySketch::summary() const
+{
+    LatencySummary s;
+
+    if (total == 0) return s;
+
+    s.mean = sum / total;
+    s.p50 = quantile(0.50);
+    s.p95 = quantile(0.95);
+    s.p99 = quantile(0.99);
+    s.p999 = quantile(0.999);
+    s.max = largest;
+
+    return s;
+}
+
+void LatencySketch::save(SnapshotWriter& w) const
+{
+    unsigned int occupied = 0;
+    for (std::size_t i = 0; i < buckets; ++i)
+        if (counts[i]) ++occupied;
+
+    w.put(zeros);
+    w.put(total);
+    w.put(sum);
+    w.put(largest);
+    w.put(occupied);
+
+    for (std::size_t i = 0; i < buckets; ++i)
+    {
+        if (counts[i] == 0) continue;
+        w.put(static_cast<unsigned int>(i));
+        w.put(counts[i]);
+    }
+}
+
+bool LatencySketch::restore(SnapshotReader& r)
+{
+    unsigned int occupied = 0;
+
+    clear();
+    r.get(zeros);
+    r.get(total);
+    r.get(sum);
+    r.get(largest);
+    r.get(occupied);
+
+    for (unsigned int k = 0; k < occupied && r.good(); ++k)
+    {
+        unsigned int i = 0;
+        unsigned long long n = 0;
+
+        r.get(i);
+        r.get(n);
+        if (i >= buckets) r.fail();
+        else counts[i] = n;
+    }
+
+    return r.good();
+}
@@ -0,0 +1,285 @@
+#include <cstdlib>     // for strtod
+#include <cstring>     // for memcpy, memcmp
+#include <stdint.h>    // for fixed-width header fields
+#include <fcntl.h>     // for open
+#include <sys/mman.h>  // for mmap, madvise
+#include <sys/stat.h>  // for fstat
+#include <unistd.h>    // for close
+#include "TraceFile.h"
+#include "ByteOrder.h"
+
+TraceWriter::TraceWriter() : count(0), last_arrival(0.0) {}
+
+TraceWriter::~TraceWriter()
+{
+    if (out.is_open()) close();
+}
+
+bool TraceWriter::open(const char* path)
+{
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        message = std::string("cannot create ") + path;
+        return false;
+    }
+
+    uint32_t version = ByteOrder::littleEndian<uint32_t>(TraceFormat::version),
+             record = ByteOrder::littleEndian<uint32_t>(TraceFormat::record_bytes);
+    uint64_t records = 0; // patched on close
+
+    out.write(TraceFormat::magic, sizeof(TraceFormat::magic));
+    out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    out.write(reinterpret_cast<const char*>(&records), sizeof(records));
+
+    count = 0;
+    last_arrival = 0.0;
+
+    return static_cast<bool>(out);
+}
+
+bool TraceWriter::append(double arrival_time, double service_time)
+{
+    if (!(arrival_time >= last_arrival) || !(service_time >= 0)) // also rejects NaN
+    {
+        message = "arrival times must be non-decreasing and service times non-negative";
+        return false;
+    }
+
+    last_arrival = arrival_time;
+    ++count;
+
+    arrival_time = ByteOrder::littleEndian(arrival_time);
+    service_time = ByteOrder::littleEndian(service_time);
+    out.write(reinterpret_cast<const char*>(&arrival_time), sizeof(double));
+    out.write(reinterpret_cast<const char*>(&service_time), sizeof(double));
+
+    return static_cast<bool>(out);
+}
+
+bool TraceWriter::close()
+{
+    uint64_t records = ByteOrder::littleEndian<uint64_t>(count);
+
+    out.seekp(16);
+    out.write(reinterpret_cast<const char*>(&records), sizeof(records));
+    out.close();
+
+    if (out.fail())
+    {
+        message = "write failed";
+        return false;
+    }
+
+    return true;
+}
+
+bool TraceWriter::fromCsv(const char* csv_path, const char* trace_path, unsigned long long& records, std::string& error)
+{
+    std::ifstream in(csv_path);
+    if (!in)
+    {
+        error = std::string("cannot open ") + csv_path;
+        return false;
+    }
+
+    TraceWriter writer;
+    if (!writer.open(trace_path))
+    {
+        error = writer.error();
+        return false;
+    }
+
+    std::string line;
+    unsigned long line_number = 0;
+
+    while (std::getline(in, line))
+    {
+        ++line_number;
+
+        const char* text = line.c_str();
+        while (*text == ' ' || *text == '\t') ++text;
+        if (*text == '\0' || *text == '\r' || *text == '#') continue;
+
+        char* stop;
+        double arrival_time = strtod(text, &stop),
+               service_time;
+
+        if (stop == text)
+        {
+            if (line_number == 1) continue; // column header
+            error = "line " + std::to_string(line_number) + ": expected arrival_time,service_time";
+            return false;
+        }
+
+        text = stop;
+        while (*text == ' ' || *text == '\t') ++text;
+        if (*text == ',') ++text;
+
+        service_time = strtod(text, &stop);
+        if (stop == text)
+        {
+            error = "line " + std::to_string(line_number) + ": missing service time";
+            return false;
+        }
+
+        if (!writer.append(arrival_time, service_time))
+        {
+            error = "line " + std::to_string(line_number) + ": " + writer.error();
+            return false;
+        }
+    }
+
+    records = writer.records();
+
+    if (!writer.close())
+    {
+        error = writer.error();
+        return false;
+    }
+
+    return true;
+}
+
+TraceReader::TraceReader() :
+    base(NULL), length(0), cursor(NULL), end(NULL), released(NULL), count(0), last_arrival(0.0) {}
+
+TraceReader::~TraceReader()
+{
+    unmap();
+}
+
+void TraceReader::unmap()
+{
+    if (base) munmap(const_cast<unsigned char*>(base), length);
+    base = cursor = end = released = NULL;
+    length = 0;
+    count = 0;
+}
+
+bool TraceReader::open(const char* path)
+{
+    unmap();
+    message.clear();
+
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        message = std::string("cannot open ") + path;
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < TraceFormat::header_bytes)
+    {
+        ::close(fd);
+        message = std::string(path) + " is not a trace file";
+        return false;
+    }
+
+    length = info.st_size;
+    void* mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps the file alive
+
+    if (mapping == MAP_FAILED)
+    {
+        length = 0;
+        message = std::string("cannot map ") + path;
+        return false;
+    }
+
+    base = static_cast<const unsigned char*>(mapping);
+    madvise(mapping, length, MADV_SEQUENTIAL); // read ahead aggressively, the replay never seeks back
+
+    uint32_t version, record;
+    uint64_t records;
+
+    memcpy(&version, base + 8, sizeof(version));
+    memcpy(&record, base + 12, sizeof(record));
+    memcpy(&records, base + 16, sizeof(records));
+    version = ByteOrder::littleEndian(version);
+    record = ByteOrder::littleEndian(record);
+    records = ByteOrder::littleEndian(records);
+
+    if (memcmp(base, TraceFormat::magic, sizeof(TraceFormat::magic)) != 0)
+        message = std::string(path) + " is not a trace file";
+    else if (version != TraceFormat::version || record != TraceFormat::record_bytes)
+        message = std::string(path) + ": unsupported trace version " + std::to_string(version);
+    else if (records > (length - TraceFormat::header_bytes) / TraceFormat::record_bytes)
+        message = std::string(path) + " is truncated";
+    else
+    {
+        count = records;
+        cursor = base + TraceFormat::header_bytes;
+        released = base;
+        end = cursor + count * TraceFormat::record_bytes;
+        last_arrival = 0.0;
+        return true;
+    }
+
+    unmap();
+    return false;
+}
+
+bool TraceReader::next(double& arrival_time, double& service_time)
+{
+    if (cursor == end) return false;
+
+    memcpy(&arrival_time, cursor, sizeof(double));
+    memcpy(&service_time, cursor + sizeof(double), sizeof(double));
+    arrival_time = ByteOrder::littleEndian(arrival_time);
+    service_time = ByteOrder::littleEndian(service_time);
+
+    if (!(arrival_time >= last_arrival) || !(service_time >= 0)) // the writer's rule; also rejects NaN
+    {
+        unsigned long long record = (cursor - base - TraceFormat::header_bytes) / TraceFormat::record_bytes;
+        message = "record " + std::to_string(record) + (arrival_time >= last_arrival ? ": negative service time"
+                                                                                     : ": arrival time goes backwards");
+        cursor = end; // the workload ends before the bad record
+        return false;
+    }
+
+    last_arrival = arrival_time;
+    cursor += TraceFormat::record_bytes;
+
+    std::size_t consumed = (cursor - base) & ~(window - 1); // whole windows behind the cursor (base is page aligned)
+    if (base + consumed > released)
+    {
+        madvise(const_cast<unsigned char*>(released), base + consumed - released, MADV_DONTNEED);
+        released = base + consumed;
+    }
+
+    return true;
+}
+
+void TraceReader::save(SnapshotWriter& w) const
+{
+    unsigned long long consumed = base ? (cursor - base - TraceFormat::header_bytes) / TraceFormat::record_bytes : 0;
+    w.put(consumed);
+    w.put(count);
+}
+
+bool TraceReader::restore(SnapshotReader& r)
+{
+    unsigned long long consumed, records;
+    if (!r.get(consumed) || !r.get(records)) return false;
+
+    if (records != count || consumed > count) // a different trace than the snapshot was taken from
+    {
+        r.fail();
+        return false;
+    }
+
+    if (base)
+    {
+        cursor = base + TraceFormat::header_bytes + consumed * TraceFormat::record_bytes;
+        last_arrival = 0.0;
+        if (consumed > 0) // order resumes from the last record handed out
+        {
+            memcpy(&last_arrival, cursor - TraceFormat::record_bytes, sizeof(double));
+            last_arrival = ByteOrder::littleEndian(last_arrival);
+        }
+    }
+    return true;
+}
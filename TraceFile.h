@@ -0,0 +1,96 @@
+#ifndef TRACE_FILE_H
+#define TRACE_FILE_H
+
+#include <cstddef>     // for size_t
+#include <fstream>     // for writing traces
+#include <string>      // for error messages
+#include "JobSource.h"
+
+// Binary workload trace, little-endian on every host (see ByteOrder.h):
+//
+//   offset 0    char[8]   magic "CPUTRACE"
+//   offset 8    uint32    format version
+//   offset 12   uint32    bytes per record
+//   offset 16   uint64    number of records
+//   offset 24   records   { double arrival_time; double service_time; }, arrivals non-decreasing
+//
+// Records are fixed size and hold the IEEE doubles' bits, so a trace replays bit-exactly
+// on any machine and the reader can walk the file in place.
+namespace TraceFormat
+{
+    const char magic[8] = { 'C', 'P', 'U', 'T', 'R', 'A', 'C', 'E' };
+    const unsigned int version = 1;
+    const std::size_t header_bytes = 24,
+                      record_bytes = 16;
+}
+
+// Appends jobs to a new trace file; the record count is patched into the header on close
+class TraceWriter
+{
+public:
+    // Constructor
+    TraceWriter();
+    // Destructor
+    ~TraceWriter();
+
+    bool open(const char* path);
+    bool append(double arrival_time, double service_time); // rejects negative times and out-of-order arrivals
+    bool close();
+
+    unsigned long long records() const { return count; }
+    const std::string& error() const { return message; }
+
+    // convert "arrival_time,service_time" lines into a trace; blank lines, '#' comments
+    // and a leading header line are skipped
+    static bool fromCsv(const char* csv_path, const char* trace_path, unsigned long long& records, std::string& error);
+
+private:
+    TraceWriter(const TraceWriter&);            // non-copyable: owns its file
+    TraceWriter& operator=(const TraceWriter&);
+
+    std::ofstream out;
+    unsigned long long count;  // records written so far
+    double last_arrival;       // to enforce arrival order
+    std::string message;       // reason for the last failure
+};
+
+// Streams a trace through a read-only memory mapping: records are decoded straight from
+// the mapped pages, one job at a time, and pages behind the cursor are handed back to
+// the kernel as the replay advances, so resident memory stays bounded for any trace size.
+class TraceReader : public JobSource
+{
+public:
+    // Constructor
+    TraceReader();
+    // Destructor
+    ~TraceReader();
+
+    bool open(const char* path); // map the file and validate its header
+
+    bool next(double& arrival_time, double& service_time); // false at the end, or at a record out of order (see error())
+
+    void save(SnapshotWriter& w) const; // records consumed so far
+    bool restore(SnapshotReader& r);    // seek the (already opened) trace to a saved position
+
+    unsigned long long records() const { return count; }
+    const std::string& error() const { return message; }
+
+private:
+    TraceReader(const TraceReader&);            // non-copyable: owns its mapping
+    TraceReader& operator=(const TraceReader&);
+
+    void unmap();
+
+    static const std::size_t window = std::size_t(64) << 20; // consumed bytes released to the kernel at a time
+
+    const unsigned char* base;     // start of the mapping
+    std::size_t length;            // bytes mapped
+    const unsigned char* cursor;   // next record
+    const unsigned char* end;      // one past the last record
+    const unsigned char* released; // pages before this have been dropped
+    unsigned long long count;      // records in the trace
+    double last_arrival;           // arrival time of the previous record, to enforce arrival order
+    std::string message;           // reason for the last failure
+};
+
+#endif // TRACE_FILE_H
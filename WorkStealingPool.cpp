@@ -0,0 +1,87 @@
+#include <algorithm>   // for sort
+#include <thread>      // for worker threads
+#include "WorkStealingPool.h"
+
+namespace
+{
+    // orders task indices by descending cost
+    struct HeavierFirst
+    {
+        const std::vector<double>& cost;
+
+        explicit HeavierFirst(const std::vector<double>& c) : cost(c) {}
+
+        bool operator()(std::size_t a, std::size_t b) const
+        {
+            return cost[a] > cost[b] || (cost[a] == cost[b] && a < b);
+        }
+    };
+}
+
+WorkStealingPool::WorkStealingPool(unsigned t)
+{
+    threads = t > 0 ? t : 1;
+}
+
+void WorkStealingPool::run(const std::vector<double>& cost, const std::function<void(std::size_t)>& task)
+{
+    std::vector<std::size_t> order(cost.size());
+    for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+
+    std::sort(order.begin(), order.end(), HeavierFirst(cost));
+
+    unsigned n = threads;
+    if (n > order.size()) n = order.size() > 0 ? static_cast<unsigned>(order.size()) : 1;
+
+    workers.clear();
+    for (unsigned w = 0; w < n; ++w) workers.push_back(new Worker());
+
+    for (std::size_t i = 0; i < order.size(); ++i)
+        workers[i % n]->tasks.push_back(order[i]); // deal heaviest tasks first so every queue starts with a long one
+
+    std::vector<std::thread> pool;
+
+    for (unsigned w = 0; w < n; ++w)
+    {
+        pool.push_back(std::thread([this, w, &task]()
+        {
+            std::size_t i;
+            while (take(w, i)) task(i);
+        }));
+    }
+
+    for (std::size_t w = 0; w < pool.size(); ++w) pool[w].join();
+
+    for (std::size_t w = 0; w < workers.size(); ++w) delete workers[w];
+    workers.clear();
+}
+
+bool WorkStealingPool::take(std::size_t self, std::size_t& task)
+{
+    {
+        std::lock_guard<std::mutex> guard(workers[self]->lock);
+
+        if (!workers[self]->tasks.empty())
+        {
+            task = workers[self]->tasks.front();
+            workers[self]->tasks.pop_front();
+            return true;
+        }
+    }
+
+    // own queue is empty: steal the heaviest remaining task from the next non-empty queue
+    for (std::size_t k = 1; k < workers.size(); ++k)
+    {
+        Worker* victim = workers[(self + k) % workers.size()];
+        std::lock_guard<std::mutex> guard(victim->lock);
+
+        if (!victim->tasks.empty())
+        {
+            task = victim->tasks.front();
+            victim->tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false; // tasks are never added during a run, so every queue is drained
+}
@@ -0,0 +1,36 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <cstddef>     // for size_t
+#include <deque>       // for per-worker task queues
+#include <functional>  // for task callback
+#include <mutex>       // for queue locks
+#include <vector>      // for worker queues and costs
+
+// Runs a batch of independent tasks on a fixed number of threads. Tasks are sorted by
+// estimated cost and dealt round-robin into per-worker queues, heaviest first; each worker
+// drains its own queue from the front and, once empty, steals the heaviest remaining task
+// from another worker. Long runs therefore start early and short runs fill in around them.
+class WorkStealingPool
+{
+public:
+    // Constructor
+    explicit WorkStealingPool(unsigned threads);
+
+    // call task(i) once for every i in [0, cost.size()); returns when all have finished
+    void run(const std::vector<double>& cost, const std::function<void(std::size_t)>& task);
+
+private:
+    struct Worker
+    {
+        std::mutex lock;
+        std::deque<std::size_t> tasks; // heaviest at front
+    };
+
+    bool take(std::size_t self, std::size_t& task); // next task from own queue, else stolen from another
+
+    unsigned threads;
+    std::vector<Worker*> workers;
+};
+
+#endif // WORK_STEALING_POOL_H
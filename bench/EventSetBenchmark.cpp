@@ -0,0 +1,59 @@
+// Micro-benchmark of the future-event set backends using the classic "hold" model:
+// the set is filled to a given size, then each operation pops the earliest event and
+// pushes a replacement an exponentially distributed increment later.
+//
+// build: cmake -S . -B build && cmake --build build --target event_set_bench
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>      // for steady_clock
+#include <random>      // for mt19937_64, exponential_distribution
+#include "../EventSet.h"
+
+namespace
+{
+    double holdRate(EventSetType type, std::size_t size, std::size_t operations)
+    {
+        std::mt19937_64 engine(size);
+        std::exponential_distribution<double> increment(1.0);
+
+        EventSet* event_q = EventSet::create(type);
+
+        for (std::size_t i = 0; i < size; ++i)
+            event_q->push(Event(increment(engine), arrival, no_process));
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for (std::size_t i = 0; i < operations; ++i)
+        {
+            double now = event_q->top().time;
+            event_q->pop();
+            event_q->push(Event(now + increment(engine), arrival, no_process));
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        delete event_q;
+
+        return operations / elapsed.count(); // hold operations (one pop plus one push) per second
+    }
+}
+
+int main()
+{
+    const std::size_t sizes[] = { 4, 16, 256, 4096, 65536, 1048576 };
+    const std::size_t operations = 4000000;
+
+    std::cout << std::setw(10) << "size"
+              << std::setw(18) << "heap events/s"
+              << std::setw(18) << "calendar events/s" << std::endl;
+
+    for (std::size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+        std::cout << std::setw(10) << sizes[i]
+                  << std::setw(18) << std::fixed << std::setprecision(0) << holdRate(indexed_heap, sizes[i], operations)
+                  << std::setw(18) << holdRate(calendar_queue, sizes[i], operations) << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,367 @@
+// End-to-end benchmark of the simulator: every scheduler at light, moderate,
+// near-saturation and overloaded load, plus Round Robin across quantum sizes, each both
+// fast-forwarded (the default) and with one event per slice. Each case runs in a child
+// process so its peak RSS is measured on its own; the event rate and run time are those
+// of the fastest of several repeats. Where the kernel exposes a hardware cache-miss
+// counter (perf_event_open), the misses of that repeat are reported too; elsewhere, e.g.
+// in most virtual machines, the column shows "-".
+//
+// build: cmake -S . -B build && cmake --build build --target simulator_bench
+// usage: simulator_bench [--jobs N] [--repeat R] [--baseline-out file] [--compare file] [--tolerance f]
+//
+// --baseline-out saves the results as CSV; --compare reads such a file and flags every
+// case whose event rate fell, or whose peak RSS grew, by more than the tolerance
+// (default 0.10). The exit status is 1 if any case regressed.
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>      // for steady_clock
+#include <cstdlib>     // for atoi, atof, atoll, strtoul
+#include <cstring>     // for strcmp, memset
+#include <unistd.h>    // for fork, pipe
+#include <sys/resource.h> // for rusage
+#include <sys/wait.h>  // for wait4
+#if defined(__linux__)
+#include <linux/perf_event.h> // for the cache-miss counter
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+#include "../Simulator.h"
+
+namespace
+{
+    const int lambda = 1000; // arrivals per unit time; Ts = rho / lambda sets the load
+
+    struct Case
+    {
+        std::string name;
+        int schedule;
+        double service_time,
+               quantum;
+        bool per_quantum;  // Round Robin without fast-forward
+    };
+
+    struct Measurement
+    {
+        unsigned long long events;
+        double events_per_second,
+               ns_per_event,
+               seconds;        // wall time of the run
+        long peak_rss_kb;
+        std::size_t peak_pending,  // future-event set depth
+                    peak_waiting;  // ready-queue depth
+        long long cache_misses;    // last-level cache misses of the run (-1: no counter)
+    };
+
+    // hardware cache-miss counter of the calling process, if the kernel provides one
+    class CacheMisses
+    {
+    public:
+        CacheMisses() : fd(-1)
+        {
+#if defined(__linux__)
+            struct perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+        }
+
+        ~CacheMisses() { if (fd >= 0) close(fd); }
+
+        void start()
+        {
+#if defined(__linux__)
+            if (fd < 0) return;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+        }
+
+        long long stop() // misses since start(), or -1
+        {
+            long long count = -1;
+#if defined(__linux__)
+            if (fd < 0) return -1;
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count))) count = -1;
+#endif
+            return count;
+        }
+
+    private:
+        int fd;
+    };
+
+    std::vector<Case> cases()
+    {
+        const char* schedulers[] = { "FCFS", "SRTF", "HRRN", "RR" };
+        const char* loads[] = { "light", "moderate", "rho0.99", "overload" };
+        const double rhos[] = { 0.3, 0.7, 0.99, 1.2 };
+        std::vector<Case> list;
+
+        for (int s = 0; s < 4; ++s)
+        {
+            for (int l = 0; l < 4; ++l)
+            {
+                Case c;
+                c.name = std::string(schedulers[s]) + "/" + loads[l];
+                c.schedule = s + 1;
+                c.service_time = rhos[l] / lambda;
+                c.quantum = c.service_time; // one mean service time per slice
+                c.per_quantum = false;
+                list.push_back(c);
+            }
+        }
+
+        const double quanta[] = { 0.01, 0.05, 0.25, 1.0, 4.0 }; // multiples of Ts at moderate load
+        for (int per_quantum = 0; per_quantum < 2; ++per_quantum)
+        {
+            for (int q = 0; q < 5; ++q)
+            {
+                std::ostringstream name;
+                name << "RR/moderate/q=" << quanta[q] << "Ts" << (per_quantum ? "/slices" : "");
+
+                Case c;
+                c.name = name.str();
+                c.schedule = 4;
+                c.service_time = 0.7 / lambda;
+                c.quantum = quanta[q] * c.service_time;
+                c.per_quantum = per_quantum != 0;
+                list.push_back(c);
+            }
+        }
+
+        return list;
+    }
+
+    Measurement runCase(const Case& c, unsigned long jobs, int repeat)
+    {
+        Measurement m;
+        CacheMisses counter;
+        m.events_per_second = 0;
+
+        for (int r = 0; r < repeat; ++r)
+        {
+            Simulator sim(c.schedule, lambda, c.service_time, c.quantum, indexed_heap, 1, 1, global_queue, NULL, jobs);
+            sim.setFastForward(!c.per_quantum);
+
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            counter.start();
+            sim.run();
+            long long misses = counter.stop();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+            double rate = sim.core().eventsProcessed() / elapsed.count();
+            if (rate > m.events_per_second)
+            {
+                m.events = sim.core().eventsProcessed();
+                m.events_per_second = rate;
+                m.ns_per_event = 1e9 / rate;
+                m.seconds = elapsed.count();
+                m.peak_pending = sim.core().peakPendingEvents();
+                m.peak_waiting = sim.core().peakWaiting();
+                m.cache_misses = misses;
+            }
+        }
+
+        return m;
+    }
+
+    // run one case in a child process, so its peak resident set is not inherited from earlier cases
+    bool measure(const Case& c, unsigned long jobs, int repeat, Measurement& m)
+    {
+        int channel[2];
+        if (pipe(channel) != 0) return false;
+
+        pid_t child = fork();
+        if (child < 0) return false;
+
+        if (child == 0)
+        {
+            close(channel[0]);
+            Measurement result = runCase(c, jobs, repeat);
+            ssize_t written = write(channel[1], &result, sizeof(result));
+            _exit(written == static_cast<ssize_t>(sizeof(result)) ? 0 : 1);
+        }
+
+        close(channel[1]);
+        ssize_t got = read(channel[0], &m, sizeof(m));
+        close(channel[0]);
+
+        int status;
+        struct rusage usage;
+        if (wait4(child, &status, 0, &usage) != child || got != static_cast<ssize_t>(sizeof(m))) return false;
+
+        m.peak_rss_kb = usage.ru_maxrss; // kilobytes on Linux
+        return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+
+    // baseline CSV: case,events,events_per_sec,ns_per_event,peak_rss_kb,peak_event_queue,peak_ready_queue,run_ms,cache_misses
+    std::map<std::string, Measurement> readBaseline(const char* path)
+    {
+        std::map<std::string, Measurement> baseline;
+        std::ifstream in(path);
+        std::string line;
+
+        while (std::getline(in, line))
+        {
+            if (line.empty() || line[0] == '#' || line.compare(0, 5, "case,") == 0) continue;
+
+            std::istringstream fields(line);
+            std::string name, value;
+            Measurement m;
+
+            std::getline(fields, name, ',');
+            std::getline(fields, value, ','); m.events = strtoull(value.c_str(), NULL, 10);
+            std::getline(fields, value, ','); m.events_per_second = atof(value.c_str());
+            std::getline(fields, value, ','); m.ns_per_event = atof(value.c_str());
+            std::getline(fields, value, ','); m.peak_rss_kb = atol(value.c_str());
+            std::getline(fields, value, ','); m.peak_pending = strtoul(value.c_str(), NULL, 10);
+            std::getline(fields, value, ','); m.peak_waiting = strtoul(value.c_str(), NULL, 10);
+            m.seconds = std::getline(fields, value, ',') ? atof(value.c_str()) / 1000.0 : 0.0; // older baselines lack these
+            m.cache_misses = std::getline(fields, value, ',') ? atoll(value.c_str()) : -1;
+
+            baseline[name] = m;
+        }
+
+        return baseline;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned long jobs = 200000;
+    int repeat = 3;
+    const char* baseline_out = NULL;
+    const char* compare = NULL;
+    double tolerance = 0.10;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) jobs = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) repeat = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--baseline-out") == 0 && i + 1 < argc) baseline_out = argv[++i];
+        else if (strcmp(argv[i], "--compare") == 0 && i + 1 < argc) compare = argv[++i];
+        else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) tolerance = atof(argv[++i]);
+        else
+        {
+            std::cout << "usage: " << argv[0] << " [--jobs N] [--repeat R] [--baseline-out file] [--compare file] [--tolerance f]\n";
+            return 2;
+        }
+    }
+
+    if (jobs == 0 || repeat < 1)
+    {
+        std::cout << "Jobs and repeats must be at least 1.\n";
+        return 2;
+    }
+
+    std::map<std::string, Measurement> baseline;
+    if (compare)
+    {
+        baseline = readBaseline(compare);
+        if (baseline.empty())
+        {
+            std::cout << "Could not read a baseline from " << compare << "\n";
+            return 2;
+        }
+    }
+
+    std::ofstream out;
+    if (baseline_out)
+    {
+        out.open(baseline_out);
+        if (!out)
+        {
+            std::cout << "Could not open " << baseline_out << " for writing.\n";
+            return 2;
+        }
+        out << std::fixed << "# jobs=" << jobs << "\n"
+            << "case,events,events_per_sec,ns_per_event,peak_rss_kb,peak_event_queue,peak_ready_queue,run_ms,cache_misses\n";
+    }
+
+    std::vector<Case> list = cases();
+    int regressions = 0;
+
+    std::cout << std::left << std::setw(28) << "case" << std::right
+              << std::setw(12) << "events"
+              << std::setw(14) << "events/s"
+              << std::setw(10) << "ns/event"
+              << std::setw(12) << "peak RSS kB"
+              << std::setw(12) << "peak events"
+              << std::setw(12) << "peak ready"
+              << std::setw(10) << "run ms"
+              << std::setw(14) << "cache misses";
+    if (compare) std::cout << "  vs baseline";
+    std::cout << std::endl;
+
+    for (std::size_t i = 0; i < list.size(); ++i)
+    {
+        Measurement m;
+        if (!measure(list[i], jobs, repeat, m))
+        {
+            std::cout << list[i].name << ": measurement failed\n";
+            return 2;
+        }
+
+        std::cout << std::left << std::setw(28) << list[i].name << std::right
+                  << std::setw(12) << m.events
+                  << std::setw(14) << std::fixed << std::setprecision(0) << m.events_per_second
+                  << std::setw(10) << std::setprecision(1) << m.ns_per_event
+                  << std::setw(12) << m.peak_rss_kb
+                  << std::setw(12) << m.peak_pending
+                  << std::setw(12) << m.peak_waiting
+                  << std::setw(10) << std::setprecision(1) << 1000 * m.seconds
+                  << std::setw(14);
+        if (m.cache_misses < 0) std::cout << "-";
+        else std::cout << m.cache_misses;
+
+        if (compare)
+        {
+            std::map<std::string, Measurement>::const_iterator b = baseline.find(list[i].name);
+
+            if (b == baseline.end()) std::cout << "  (new case)";
+            else
+            {
+                double speed = m.events_per_second / b->second.events_per_second - 1.0,
+                       memory = static_cast<double>(m.peak_rss_kb) / b->second.peak_rss_kb - 1.0;
+
+                std::cout << "  " << std::showpos << std::setprecision(1) << 100 * speed << "% rate, "
+                          << 100 * memory << "% RSS" << std::noshowpos;
+
+                if (m.events != b->second.events) std::cout << " (event count changed)";
+                if (m.cache_misses >= 0 && b->second.cache_misses > 0)
+                    std::cout << ", " << std::showpos << std::setprecision(1)
+                              << 100.0 * (static_cast<double>(m.cache_misses) / b->second.cache_misses - 1.0) << "% misses" << std::noshowpos;
+                if (speed < -tolerance || memory > tolerance)
+                {
+                    std::cout << "  REGRESSION";
+                    ++regressions;
+                }
+            }
+        }
+        std::cout << std::endl;
+
+        if (baseline_out)
+        {
+            out << list[i].name << "," << m.events << "," << std::setprecision(0) << m.events_per_second << ","
+                << std::setprecision(2) << m.ns_per_event << "," << m.peak_rss_kb << "," << m.peak_pending << "," << m.peak_waiting << ","
+                << 1000 * m.seconds << "," << m.cache_misses << "\n";
+        }
+    }
+
+    if (compare) std::cout << regressions << " regression(s) beyond " << 100 * tolerance << "%" << std::endl;
+
+    return regressions ? 1 : 0;
+}
@@ -1,53 +1,794 @@
-#include <iostream>
-#include <cstdlib>
-#include "Simulator.h"
-
-int main(int argc, char* argv[])
-{
-    if (argc != 5)
-    {
-        std::cout << "usage: " << argv[0] << ", scheduler (1-4), "
-                  << "lambda, Ts, Quantum interval\n";
-        exit(-1);
-    }
-
-    int scheduler = atoi(argv[1]);
-    if (scheduler < 1 || scheduler > 4)
-    {
-        std::cout << "Scheduler must be designated by a number 1-4\n"
-                  << "1. First Come First Serve\n"
-                  << "2. Shortest Remaining Time First\n"
-                  << "3. Highest Response Ratio Next\n"
-                  << "4. Round Robin\n"
-                  << "Please enter one of the available selections.\n";
-        exit(-1);
-    }
-
-    int lambda = atoi(argv[2]);
-    if (lambda < 1)
-    {
-        std::cout << "Average arrival rate must be an integer "
-                  << "greater than 1.\n";
-        exit(-1);
-    }
-
-    double service_time = atof(argv[3]);
-    if (service_time < 0)
-    {
-        std::cout << "Average service time cannot be negative.\n";
-        exit(-1);
-    }
-
-    double quantum = atof(argv[4]);
-    if (quantum < 0)
-    {
-        std::cout << "Quantum (time slice) cannot be negative.\n";
-        exit(-1);
-    }
-
-    Simulator cpu_scheduler(scheduler, lambda, service_time, quantum);
-
-    cpu_scheduler.simulate();
-
-    return 0;
-}
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <chrono>
+#include "Simulator.h"
+#include "ReplicationRunner.h"
+#include "ParameterSweep.h"
+#include "AnalyticModel.h"
+#include "TraceFile.h"
+#include "ResultsExport.h"
+#include "WorkStealingPool.h"
+
+// parse --event-set's argument; exits on an unknown backend
+static EventSetType parseEventSet(const char* name)
+{
+    if (strcmp(name, "heap") == 0) return indexed_heap;
+    if (strcmp(name, "calendar") == 0) return calendar_queue;
+
+    std::cout << "Event set must be one of: heap, calendar\n";
+    exit(-1);
+}
+
+// parse --balance's argument; exits on an unknown strategy
+static BalanceStrategy parseBalance(const char* name)
+{
+    if (strcmp(name, "global") == 0) return global_queue;
+    if (strcmp(name, "random") == 0) return random_push;
+    if (strcmp(name, "two-choice") == 0) return two_choices;
+    if (strcmp(name, "steal") == 0) return work_stealing;
+
+    std::cout << "Balance strategy must be one of: global, random, two-choice, steal\n";
+    exit(-1);
+}
+
+// sweep mode: every combination of the four value lists, one CSV row per point
+static int sweep(int argc, char* argv[])
+{
+    std::vector<double> values[4];
+    const char* names[4] = { "scheduler", "lambda", "Ts", "quantum" };
+
+    for (int k = 0; k < 4; ++k)
+    {
+        if (!ParameterSweep::parseRange(argv[k + 2], values[k]))
+        {
+            std::cout << "Could not parse " << names[k] << " values: " << argv[k + 2] << "\n";
+            exit(-1);
+        }
+    }
+
+    for (std::size_t i = 0; i < values[0].size(); ++i)
+    {
+        if (values[0][i] < 1 || values[0][i] > 5 || values[0][i] != static_cast<int>(values[0][i]))
+        {
+            std::cout << "Scheduler must be designated by a number 1-5, not " << values[0][i] << "\n";
+            exit(-1);
+        }
+    }
+    for (std::size_t i = 0; i < values[1].size(); ++i)
+    {
+        if (values[1][i] < 1 || values[1][i] != static_cast<int>(values[1][i]))
+        {
+            std::cout << "Average arrival rate must be an integer greater than 1, not " << values[1][i] << "\n";
+            exit(-1);
+        }
+    }
+    for (std::size_t i = 0; i < values[2].size(); ++i)
+    {
+        if (values[2][i] < 0)
+        {
+            std::cout << "Average service time cannot be negative.\n";
+            exit(-1);
+        }
+    }
+    bool slicing = false; // Round Robin or MLFQ in the sweep: their quanta must be positive
+    for (std::size_t i = 0; i < values[0].size(); ++i) slicing = slicing || values[0][i] >= 4;
+
+    for (std::size_t i = 0; i < values[3].size(); ++i)
+    {
+        if (values[3][i] < 0 || (slicing && values[3][i] == 0))
+        {
+            std::cout << "Quantum (time slice) must be " << (slicing ? "positive for Round Robin and MLFQ" : "non-negative")
+                      << ", not " << values[3][i] << "\n";
+            exit(-1);
+        }
+    }
+
+    EventSetType event_set = indexed_heap;
+    unsigned long seed = 1;
+    unsigned threads = std::thread::hardware_concurrency();
+    const char* out_file = NULL;
+    bool analytic = false;
+
+    for (int i = 6; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--event-set") == 0 && i + 1 < argc) event_set = parseEventSet(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            int t = atoi(argv[++i]);
+            if (t < 1)
+            {
+                std::cout << "Threads must be at least 1.\n";
+                exit(-1);
+            }
+            threads = t;
+        }
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) out_file = argv[++i];
+        else if (strcmp(argv[i], "--analytic") == 0) analytic = true;
+        else
+        {
+            std::cout << "Unrecognized option: " << argv[i] << "\n";
+            exit(-1);
+        }
+    }
+
+    ParameterSweep grid(values[0], values[1], values[2], values[3]);
+
+    if (out_file == NULL)
+    {
+        if (analytic) grid.runAnalytic(std::cout);
+        else grid.run(std::cout, threads, event_set, seed);
+        return 0;
+    }
+
+    std::ofstream fout(out_file);
+    if (!fout)
+    {
+        std::cout << "Could not open " << out_file << " for writing.\n";
+        exit(-1);
+    }
+
+    if (analytic) grid.runAnalytic(fout);
+    else grid.run(fout, threads, event_set, seed);
+    std::cout << grid.size() << " points written to " << out_file << "\n";
+
+    return 0;
+}
+
+// convert mode: CSV job log to binary trace
+static int convertTrace(const char* csv, const char* trace)
+{
+    unsigned long long records = 0;
+    std::string error;
+
+    if (!TraceWriter::fromCsv(csv, trace, records, error))
+    {
+        std::cout << "Could not convert " << csv << ": " << error << "\n";
+        exit(-1);
+    }
+
+    std::cout << records << " jobs written to " << trace << "\n";
+    return 0;
+}
+
+// timeline export mode: binary event trace to Chrome trace / Perfetto JSON
+static int exportTimeline(const char* timeline, const char* json)
+{
+    unsigned long long records = 0;
+    std::string error;
+
+    if (!exportChromeTrace(timeline, json, records, error))
+    {
+        std::cout << "Could not export " << timeline << ": " << error << "\n";
+        exit(-1);
+    }
+
+    std::cout << records << " events written to " << json << "\n";
+    return 0;
+}
+
+// export mode: write the synthetic workload of (lambda, Ts, seed) as a trace, so the same
+// jobs can be replayed with --trace on any machine
+static int exportTrace(int argc, char* argv[])
+{
+    int lambda = atoi(argv[2]);
+    double service_time = atof(argv[3]);
+    unsigned long long count = strtoull(argv[4], NULL, 10);
+    const char* trace = argv[5];
+    unsigned long seed = 1;
+
+    if (lambda < 1 || service_time < 0)
+    {
+        std::cout << "Average arrival rate must be at least 1 and service time non-negative.\n";
+        exit(-1);
+    }
+
+    for (int i = 6; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = strtoul(argv[++i], NULL, 10);
+        else
+        {
+            std::cout << "Unrecognized option: " << argv[i] << "\n";
+            exit(-1);
+        }
+    }
+
+    SyntheticJobSource source(lambda, service_time, seed);
+    TraceWriter writer;
+
+    if (!writer.open(trace))
+    {
+        std::cout << "Could not write trace: " << writer.error() << "\n";
+        exit(-1);
+    }
+
+    double arrival_time, job_service_time;
+    for (unsigned long long i = 0; i < count && source.next(arrival_time, job_service_time); ++i)
+        writer.append(arrival_time, job_service_time);
+
+    if (!writer.close())
+    {
+        std::cout << "Could not write trace: " << writer.error() << "\n";
+        exit(-1);
+    }
+
+    std::cout << writer.records() << " jobs written to " << trace << "\n";
+    return 0;
+}
+
+// fork mode: run to the warm-up point, clone that state once per quantum and continue
+// every clone for the same number of further completions, measured from the fork
+static int forkQuanta(Simulator& warm, const std::vector<double>& quanta, unsigned long warmup,
+                      unsigned long jobs, unsigned threads)
+{
+    warm.setFastForward(false); // no slices played past the fork at the old quantum
+    warm.setJobLimit(warmup);
+    warm.run();
+
+    std::vector<Simulator*> continuations;
+    std::string error;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bool forked = warm.fork(quanta, continuations, error);
+    std::chrono::duration<double, std::milli> fork_time = std::chrono::steady_clock::now() - start;
+
+    if (!forked)
+    {
+        std::cout << "Could not fork: " << error << "\n";
+        exit(-1);
+    }
+
+    std::cout << "Forked " << continuations.size() << " continuations after " << warmup << " jobs at t = "
+              << warm.core().now() << " (snapshot " << warm.snapshot().size() << " bytes, "
+              << fork_time.count() << " ms)" << std::endl;
+
+    std::vector<SimulationResults> results(continuations.size());
+    WorkStealingPool pool(threads);
+
+    pool.run(std::vector<double>(continuations.size(), 1.0), [&](std::size_t i)
+    {
+        continuations[i]->resetStatistics();
+        continuations[i]->setJobLimit(jobs);
+        results[i] = continuations[i]->run();
+    });
+
+    std::cout << "quantum, Tq, W, Rho, Throughput, Tq p99" << std::endl;
+    for (std::size_t i = 0; i < continuations.size(); ++i)
+    {
+        std::cout << quanta[i] << ", " << results[i].turnaround_time << ", " << results[i].processes_in_queue << ", "
+                  << results[i].cpu_usage << ", " << results[i].throughput << ", " << results[i].turnaround.p99 << std::endl;
+        delete continuations[i];
+    }
+
+    return 0;
+}
+
+// analytic mode: the M/M/1 expected values of the configuration, without simulating
+static void printAnalytic(const AnalyticResults& a)
+{
+    std::cout << "M/M/1 expected values" << std::endl;
+
+    if (!a.stable)
+        std::cout << "Tq: unbounded (rho >= 1)" << std::endl
+                  << "W:  unbounded" << std::endl;
+    else if (!a.exact)
+        std::cout << "Tq: " << a.turnaround_time << " to " << a.turnaround_upper
+                  << " (no closed form: between non-preemptive SJF and FCFS)" << std::endl
+                  << "W:  " << a.processes_in_queue << " to " << a.queue_upper << std::endl;
+    else
+        std::cout << "Tq: " << a.turnaround_time << std::endl
+                  << "W:  " << a.processes_in_queue << std::endl;
+
+    std::cout << "Rho: " << a.cpu_usage << std::endl
+              << "Throughput: " << a.throughput << std::endl;
+}
+
+// oracle: whether each replicated interval agrees with the M/M/1 expectation (Tq and W
+// only while the queue is stable); prints one line per metric
+static bool checkAnalytic(int schedule, const ReplicationSummary& summary, const AnalyticResults& a, double tolerance)
+{
+    const char* names[4] = { "Tq", "W", "Rho", "Throughput" };
+    const ConfidenceInterval* simulated[4] = { &summary.turnaround_time, &summary.processes_in_queue,
+                                               &summary.cpu_usage, &summary.throughput };
+    double low[4] = { a.turnaround_time, a.processes_in_queue, a.cpu_usage, a.throughput },
+           high[4] = { a.turnaround_upper, a.queue_upper, a.cpu_usage, a.throughput };
+    bool all = true;
+
+    std::cout << "M/M/1 check of scheduler " << schedule << " (tolerance " << tolerance << "):" << std::endl;
+    for (int k = a.stable ? 0 : 2; k < 4; ++k)
+    {
+        bool ok = agrees(*simulated[k], low[k], high[k], tolerance);
+        all = all && ok;
+
+        std::cout << "  " << names[k] << ": expected " << low[k];
+        if (high[k] != low[k]) std::cout << " to " << high[k];
+        std::cout << (ok ? ", agrees" : ", DISAGREES") << std::endl;
+    }
+
+    return all;
+}
+
+// comparison mode: another scheduler's intervals over the same seeds, each next to the
+// interval of its paired difference from the first scheduler
+static void printComparison(int base, int other, const ReplicationSummary& a, const ReplicationSummary& b)
+{
+    PairedDifference d = pairedDifference(a, b);
+    const char* names[4] = { "Tq: ", "W:  ", "Rho: ", "Throughput: " };
+    const ConfidenceInterval* own[4] = { &b.turnaround_time, &b.processes_in_queue, &b.cpu_usage, &b.throughput },
+                            * paired[4] = { &d.turnaround_time, &d.processes_in_queue, &d.cpu_usage, &d.throughput };
+
+    std::cout << "Scheduler " << other << " on the same jobs (difference from scheduler " << base << "):" << std::endl;
+    for (int k = 0; k < 4; ++k)
+        std::cout << names[k] << own[k]->mean << " +/- " << own[k]->half_width
+                  << "   (" << paired[k]->mean << " +/- " << paired[k]->half_width << ")" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc >= 6 && strcmp(argv[1], "--sweep") == 0) return sweep(argc, argv);
+    if (argc == 4 && strcmp(argv[1], "--convert-trace") == 0) return convertTrace(argv[2], argv[3]);
+    if (argc >= 6 && strcmp(argv[1], "--export-trace") == 0) return exportTrace(argc, argv);
+    if (argc == 4 && strcmp(argv[1], "--export-chrome") == 0) return exportTimeline(argv[2], argv[3]);
+
+    if (argc < 5)
+    {
+        std::cout << "usage: " << argv[0] << ", scheduler (1-5), "
+                  << "lambda, Ts, Quantum interval\n"
+                  << "       " << argv[0] << " --sweep schedulers lambdas Ts-values quanta [--out file] [--analytic]\n"
+                  << "       (each list is comma separated values or start:stop:step ranges, e.g. 1,4 1:20:1 0.01:0.05:0.01 0.01)\n"
+                  << "       " << argv[0] << " --convert-trace jobs.csv out.trace   (lines of arrival_time,service_time)\n"
+                  << "       " << argv[0] << " --export-trace lambda Ts jobs out.trace [--seed S]\n"
+                  << "       " << argv[0] << " --export-chrome events.bin out.json   (view in Perfetto or chrome://tracing)\n"
+                  << "options:\n"
+                  << "  --event-set heap|calendar   future-event set backend (default heap)\n"
+                  << "  --seed S                    random seed (default 1)\n"
+                  << "  --cpus K                    simulate K cpus, each with its own ready queue (default 1)\n"
+                  << "  --balance global|random|two-choice|steal\n"
+                  << "                              how processes are spread over the cpus (default global)\n"
+                  << "  --trace file                replay the jobs of a binary trace (lambda and Ts are ignored)\n"
+                  << "  --event-trace file          record every arrival, dispatch, preemption, slice and departure\n"
+                  << "  --jobs N                    processes to complete before stopping (default 10000; 0: the whole --trace)\n"
+                  << "  --precision P               instead of --jobs: drop the warm-up (MSER-5), then run until the 95%\n"
+                  << "                              batch-means half-width is within P of the mean (e.g. 0.05)\n"
+                  << "  --metric tq|wait            quantity --precision applies to (default tq)\n"
+                  << "  --max-jobs N                cap on the jobs a --precision run simulates (default 10000000)\n"
+                  << "  --save-snapshot file        save the complete simulator state at the end of the run\n"
+                  << "  --load-snapshot file        continue from a saved state (same scheduler, cpus and workload)\n"
+                  << "  --warmup N --fork-quanta L  run N jobs, then continue Round Robin from that state once per\n"
+                  << "                              quantum in L for --jobs more completions each\n"
+                  << "  --levels N                  MLFQ priority levels, quanta doubling from the quantum (default 3)\n"
+                  << "  --level-quanta L            MLFQ quantum of each level, highest priority first (overrides --levels)\n"
+                  << "  --boost T                   MLFQ priority boost period (default 100 quanta, 0: never)\n"
+                  << "  --per-quantum               one event per Round Robin slice, no fast-forward (same results)\n"
+                  << "  --replications N            run N independent replications of --jobs completions, seeds S..S+N-1\n"
+                  << "  --antithetic                draw the workload from 1 - U in place of every U; with --replications,\n"
+                  << "                              run every seed both ways and count each pair as one sample\n"
+                  << "  --compare L                 with --replications: also run the schedulers in L on the same seeds\n"
+                  << "                              (same jobs) and report their paired differences from the first\n"
+                  << "  --lindley                   FCFS on one cpu: run the replications 8 at a time without the event\n"
+                  << "                              loop (same Tq, W, Rho and throughput; no distributions per run)\n"
+                  << "  --threads T                 threads for replications, sweep points or forks (default: all cores)\n"
+                  << "  --analytic                  M/M/1 expected Tq, W, Rho and throughput instead of simulating (one cpu;\n"
+                  << "                              HRRN gets bounds); with --replications, check the intervals against them\n"
+                  << "  --tolerance f               allowance for the bias of finite runs in that check, as a fraction of\n"
+                  << "                              the expected value (default 0.05)\n";
+        exit(-1);
+    }
+
+    int scheduler = atoi(argv[1]);
+    if (scheduler < 1 || scheduler > 5)
+    {
+        std::cout << "Scheduler must be designated by a number 1-5\n"
+                  << "1. First Come First Serve\n"
+                  << "2. Shortest Remaining Time First\n"
+                  << "3. Highest Response Ratio Next\n"
+                  << "4. Round Robin\n"
+                  << "5. Multi-Level Feedback Queue\n"
+                  << "Please enter one of the available selections.\n";
+        exit(-1);
+    }
+
+    int lambda = atoi(argv[2]);
+    if (lambda < 1)
+    {
+        std::cout << "Average arrival rate must be an integer "
+                  << "greater than 1.\n";
+        exit(-1);
+    }
+
+    double service_time = atof(argv[3]);
+    if (service_time < 0)
+    {
+        std::cout << "Average service time cannot be negative.\n";
+        exit(-1);
+    }
+
+    double quantum = atof(argv[4]);
+    if (quantum < 0)
+    {
+        std::cout << "Quantum (time slice) cannot be negative.\n";
+        exit(-1);
+    }
+
+    EventSetType event_set = indexed_heap;
+    unsigned long seed = 1;
+    int replications = 0;
+    int cpus = 1;
+    BalanceStrategy balance = global_queue;
+    const char* trace = NULL;
+    const char* event_trace = NULL;
+    const char* save_snapshot = NULL;
+    const char* load_snapshot = NULL;
+    unsigned long warmup = 0;
+    std::vector<double> fork_quanta;
+    unsigned long jobs = 10000;
+    RunLengthOptions run_length;
+    unsigned int levels = 3;
+    std::vector<double> level_quanta;
+    double boost = -1;         // negative: the default for the quantum
+    bool controlled = false;
+    bool per_quantum = false;
+    bool lindley = false;
+    bool analytic = false;
+    double tolerance = 0.05;
+    bool antithetic = false;
+    std::vector<double> compare;
+    unsigned threads = std::thread::hardware_concurrency();
+
+    for (int i = 5; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--event-set") == 0 && i + 1 < argc)
+        {
+            event_set = parseEventSet(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            seed = strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--cpus") == 0 && i + 1 < argc)
+        {
+            cpus = atoi(argv[++i]);
+            if (cpus < 1)
+            {
+                std::cout << "Cpus must be at least 1.\n";
+                exit(-1);
+            }
+        }
+        else if (strcmp(argv[i], "--balance") == 0 && i + 1 < argc)
+        {
+            balance = parseBalance(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+        {
+            trace = argv[++i];
+
+            TraceReader reader;
+            if (!reader.open(trace))
+            {
+                std::cout << "Could not read trace: " << reader.error() << "\n";
+                exit(-1);
+            }
+        }
+        else if (strcmp(argv[i], "--event-trace") == 0 && i + 1 < argc)
+        {
+            event_trace = argv[++i];
+        }
+        else if (strcmp(argv[i], "--save-snapshot") == 0 && i + 1 < argc)
+        {
+            save_snapshot = argv[++i];
+        }
+        else if (strcmp(argv[i], "--load-snapshot") == 0 && i + 1 < argc)
+        {
+            load_snapshot = argv[++i];
+        }
+        else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc)
+        {
+            warmup = strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--fork-quanta") == 0 && i + 1 < argc)
+        {
+            if (!ParameterSweep::parseRange(argv[++i], fork_quanta))
+            {
+                std::cout << "Could not parse quanta: " << argv[i] << "\n";
+                exit(-1);
+            }
+        }
+        else if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc)
+        {
+            jobs = strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--precision") == 0 && i + 1 < argc)
+        {
+            run_length.precision = atof(argv[++i]);
+            if (run_length.precision <= 0)
+            {
+                std::cout << "Precision must be a positive fraction of the mean.\n";
+                exit(-1);
+            }
+            controlled = true;
+        }
+        else if (strcmp(argv[i], "--metric") == 0 && i + 1 < argc)
+        {
+            ++i;
+            if (strcmp(argv[i], "tq") == 0) run_length.metric = metric_turnaround;
+            else if (strcmp(argv[i], "wait") == 0) run_length.metric = metric_waiting;
+            else
+            {
+                std::cout << "Unknown metric: " << argv[i] << " (expected tq or wait)\n";
+                exit(-1);
+            }
+        }
+        else if (strcmp(argv[i], "--max-jobs") == 0 && i + 1 < argc)
+        {
+            run_length.max_jobs = strtoul(argv[++i], NULL, 10);
+            if (run_length.max_jobs < 1)
+            {
+                std::cout << "The job cap must be at least 1.\n";
+                exit(-1);
+            }
+        }
+        else if (strcmp(argv[i], "--levels") == 0 && i + 1 < argc)
+        {
+            int n = atoi(argv[++i]);
+            if (n < 1 || n > static_cast<int>(PriorityArray::max_levels))
+            {
+                std::cout << "Levels must be between 1 and " << PriorityArray::max_levels << ".\n";
+                exit(-1);
+            }
+            levels = n;
+        }
+        else if (strcmp(argv[i], "--level-quanta") == 0 && i + 1 < argc)
+        {
+            level_quanta.clear();
+            if (!ParameterSweep::parseRange(argv[++i], level_quanta) || level_quanta.size() > PriorityArray::max_levels)
+            {
+                std::cout << "Could not parse level quanta: " << argv[i] << "\n";
+                exit(-1);
+            }
+        }
+        else if (strcmp(argv[i], "--boost") == 0 && i + 1 < argc)
+        {
+            boost = atof(argv[++i]);
+            if (boost < 0)
+            {
+                std::cout << "The boost period cannot be negative.\n";
+                exit(-1);
+            }
+        }
+        else if (strcmp(argv[i], "--per-quantum") == 0)
+        {
+            per_quantum = true;
+        }
+        else if (strcmp(argv[i], "--replications") == 0 && i + 1 < argc)
+        {
+            replications = atoi(argv[++i]);
+            if (replications < 2)
+            {
+                std::cout << "Replications must be at least 2: one run gives no confidence interval.\n";
+                exit(-1);
+            }
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            int t = atoi(argv[++i]);
+            if (t < 1)
+            {
+                std::cout << "Threads must be at least 1.\n";
+                exit(-1);
+            }
+            threads = t;
+        }
+        else if (strcmp(argv[i], "--lindley") == 0)
+        {
+            lindley = true;
+        }
+        else if (strcmp(argv[i], "--analytic") == 0)
+        {
+            analytic = true;
+        }
+        else if (strcmp(argv[i], "--antithetic") == 0)
+        {
+            antithetic = true;
+        }
+        else if (strcmp(argv[i], "--compare") == 0 && i + 1 < argc)
+        {
+            if (!ParameterSweep::parseRange(argv[++i], compare))
+            {
+                std::cout << "Could not parse schedulers: " << argv[i] << "\n";
+                exit(-1);
+            }
+            for (std::size_t k = 0; k < compare.size(); ++k)
+            {
+                if (compare[k] < 1 || compare[k] > 5 || compare[k] != static_cast<int>(compare[k]))
+                {
+                    std::cout << "Schedulers to compare must be numbers 1-5\n";
+                    exit(-1);
+                }
+            }
+        }
+        else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc)
+        {
+            tolerance = atof(argv[++i]);
+            if (tolerance < 0)
+            {
+                std::cout << "The tolerance cannot be negative.\n";
+                exit(-1);
+            }
+        }
+        else
+        {
+            std::cout << "Unrecognized option: " << argv[i] << "\n";
+            exit(-1);
+        }
+    }
+
+    MLFQParameters mlfq = MLFQParameters::standard(quantum, levels);
+    if (!level_quanta.empty()) mlfq.quanta = level_quanta;
+    if (boost >= 0) mlfq.boost_period = boost;
+
+    bool round_robin = scheduler == 4, feedback = scheduler == 5; // schedulers that slice the cpu, compared ones included
+    for (std::size_t k = 0; k < compare.size(); ++k)
+    {
+        round_robin = round_robin || compare[k] == 4;
+        feedback = feedback || compare[k] == 5;
+    }
+
+    if (round_robin && quantum <= 0) // a slice that takes no time never ends
+    {
+        std::cout << "Round Robin needs a positive quantum (time slice), not " << quantum << "\n";
+        exit(-1);
+    }
+
+    for (std::size_t i = 0; feedback && i < mlfq.quanta.size(); ++i)
+    {
+        if (mlfq.quanta[i] <= 0)
+        {
+            std::cout << "MLFQ quanta must be positive, not " << mlfq.quanta[i] << "\n";
+            exit(-1);
+        }
+    }
+
+    for (std::size_t i = 0; i < fork_quanta.size(); ++i)
+    {
+        if (fork_quanta[i] <= 0)
+        {
+            std::cout << "Quanta to fork must be positive, not " << fork_quanta[i] << "\n";
+            exit(-1);
+        }
+    }
+
+    if (replications > 0 && trace)
+    {
+        std::cout << "A trace replays the same jobs every time; replications need the synthetic workload.\n";
+        exit(-1);
+    }
+
+    if (!fork_quanta.empty() && (scheduler != 4 || warmup == 0))
+    {
+        std::cout << "--fork-quanta needs the Round Robin scheduler (4) and a --warmup job count.\n";
+        exit(-1);
+    }
+
+    if (jobs == 0 && !trace && !controlled) // --precision stops at its own cap
+    {
+        std::cout << "A run needs a job count: the synthetic workload never runs out (--jobs 0 needs a --trace).\n";
+        exit(-1);
+    }
+
+    if (replications > 0 && (event_trace || save_snapshot || load_snapshot || !fork_quanta.empty()))
+    {
+        std::cout << "Replications cannot be combined with event traces, snapshots or forks.\n";
+        exit(-1);
+    }
+
+    if (controlled && (replications > 0 || !fork_quanta.empty()))
+    {
+        std::cout << "--precision sets the length of a single run; it cannot be combined with replications or forks.\n";
+        exit(-1);
+    }
+
+    if (lindley && (scheduler != 1 || cpus != 1 || replications == 0))
+    {
+        std::cout << "--lindley runs replications of First Come First Serve (1) on one cpu.\n";
+        exit(-1);
+    }
+
+    if (analytic && (cpus != 1 || trace || event_trace || save_snapshot || load_snapshot || !fork_quanta.empty() || controlled))
+    {
+        std::cout << "--analytic models the synthetic workload on one cpu; it cannot be combined with traces, snapshots, forks or --precision.\n";
+        exit(-1);
+    }
+
+    if (!compare.empty() && replications == 0)
+    {
+        std::cout << "--compare pairs the schedulers seed by seed; it needs --replications.\n";
+        exit(-1);
+    }
+
+    if (antithetic && trace)
+    {
+        std::cout << "--antithetic mirrors the synthetic workload's random numbers; a trace has none.\n";
+        exit(-1);
+    }
+
+    if (analytic && replications == 0)
+    {
+        printAnalytic(analyticResults(scheduler, lambda, service_time));
+        return 0;
+    }
+
+    if (replications > 0)
+    {
+        std::vector<unsigned long> seeds;
+        for (int i = 0; i < replications; ++i) seeds.push_back(seed + i);
+
+        // the scheduler, then those it is compared with: the same seeds give every one the same jobs
+        std::vector<int> schedules(1, scheduler);
+        for (std::size_t k = 0; k < compare.size(); ++k) schedules.push_back(static_cast<int>(compare[k]));
+
+        std::vector<ReplicationSummary> summaries;
+        for (std::size_t k = 0; k < schedules.size(); ++k)
+        {
+            ReplicationRunner runner(schedules[k], lambda, service_time, quantum, event_set, cpus, balance, mlfq);
+            runner.setJobLimit(jobs);
+            runner.setLindley(lindley);
+            runner.setAntithetic(antithetic);
+            summaries.push_back(runner.run(seeds, threads));
+        }
+
+        const ReplicationSummary& summary = summaries[0];
+        std::ofstream fout("sim.json");
+
+        if (schedules.size() == 1) writeJson(fout, summary);
+        else writeJson(fout, schedules, summaries);
+
+        std::cout << "Replications: " << replications << (antithetic ? " antithetic pairs" : "") << " (95% confidence)" << std::endl
+                  << "Tq: " << summary.turnaround_time.mean << " +/- " << summary.turnaround_time.half_width << std::endl
+                  << "W:  " << summary.processes_in_queue.mean << " +/- " << summary.processes_in_queue.half_width << std::endl
+                  << "Rho: " << summary.cpu_usage.mean << " +/- " << summary.cpu_usage.half_width << std::endl
+                  << "Throughput: " << summary.throughput.mean << " +/- " << summary.throughput.half_width << std::endl;
+
+        for (std::size_t k = 1; k < schedules.size(); ++k) printComparison(scheduler, schedules[k], summary, summaries[k]);
+
+        bool agreed = true;
+        for (std::size_t k = 0; analytic && k < schedules.size(); ++k)
+            agreed = checkAnalytic(schedules[k], summaries[k], analyticResults(schedules[k], lambda, service_time), tolerance) && agreed;
+
+        return agreed ? 0 : 1;
+    }
+
+    Simulator cpu_scheduler(scheduler, lambda, service_time, quantum, event_set, seed, cpus, balance, trace, jobs, mlfq, antithetic);
+
+    if (load_snapshot)
+    {
+        std::string error;
+        if (!cpu_scheduler.load(load_snapshot, error))
+        {
+            std::cout << "Could not load snapshot: " << error << "\n";
+            exit(-1);
+        }
+    }
+
+    if (!fork_quanta.empty()) return forkQuanta(cpu_scheduler, fork_quanta, warmup, jobs, threads);
+
+    if (event_trace && !cpu_scheduler.traceTo(event_trace)) exit(-1);
+    if (controlled) cpu_scheduler.controlRunLength(run_length);
+    if (per_quantum) cpu_scheduler.setFastForward(false);
+
+    cpu_scheduler.simulate();
+
+    if (save_snapshot)
+    {
+        std::string error;
+        if (!cpu_scheduler.save(save_snapshot, error))
+        {
+            std::cout << "Could not save snapshot: " << error << "\n";
+            exit(-1);
+        }
+    }
+
+    return 0;
+}
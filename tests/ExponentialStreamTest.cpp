@@ -0,0 +1,129 @@
+// Regression test of the workload's random streams on fixed seeds: the sample mean and
+// quantiles of ExponentialStream against 1/lambda and -ln(1 - p)/lambda, independence
+// of each job's inter-arrival gap and service time from SyntheticJobSource, and
+// ExponentialBatch reproducing ExponentialStream exactly (plain and antithetic).
+// Tolerances are 5 standard errors; the seeds are fixed, so the outcome is too.
+//
+// build: cmake -S . -B build && cmake --build build && ctest --test-dir build
+
+#include <iostream>
+#include <algorithm>   // for sort
+#include <cmath>       // for log, sqrt, fabs
+#include <vector>
+#include "../ExponentialStream.h"
+#include "../JobSource.h"
+
+namespace
+{
+    const unsigned long seeds[] = { 1, 2, 12345 };
+    const std::size_t draws = 1000000;
+    int failures = 0;
+
+    void check(bool ok, const char* what, unsigned long seed, double got, double expected)
+    {
+        if (ok) return;
+
+        std::cout << "FAIL seed " << seed << ": " << what << " = " << got << ", expected " << expected << std::endl;
+        ++failures;
+    }
+
+    void distribution(unsigned long seed)
+    {
+        const double lambda = 10.0;
+        ExponentialStream stream(1.0 / lambda, seed, 0);
+        std::vector<double> x(draws);
+
+        double sum = 0.0;
+        for (std::size_t i = 0; i < draws; ++i) sum += x[i] = stream.next();
+
+        double mean = sum / draws;
+        check(std::fabs(mean - 1.0 / lambda) <= 5.0 / lambda / std::sqrt(double(draws)), "mean", seed, mean, 1.0 / lambda);
+
+        std::sort(x.begin(), x.end());
+
+        const double p[] = { 0.1, 0.25, 0.5, 0.75, 0.9, 0.99 };
+        for (int k = 0; k < 6; ++k)
+        {
+            double expected = -std::log(1.0 - p[k]) / lambda,
+                   got = x[static_cast<std::size_t>(p[k] * draws)],
+                   error = std::sqrt(p[k] * (1.0 - p[k]) / draws) / (lambda * (1.0 - p[k])); // standard error of the quantile
+            check(std::fabs(got - expected) <= 5.0 * error, "quantile", seed, got, expected);
+        }
+    }
+
+    // decile of an exponential variate with the given mean
+    int decile(double x, double mean)
+    {
+        int d = static_cast<int>(10.0 * (1.0 - std::exp(-x / mean)));
+        return d < 0 ? 0 : d > 9 ? 9 : d;
+    }
+
+    void independence(unsigned long seed)
+    {
+        const int lambda = 10;
+        const double service_mean = 0.07;
+        SyntheticJobSource source(lambda, service_mean, seed);
+
+        double previous = 0.0, arrival, service;
+        double sg = 0, ss = 0, sgg = 0, sss = 0, sgs = 0;
+        std::vector<double> counts(100, 0.0);
+
+        source.next(previous, service); // the first job arrives at 0 and has no gap
+        for (std::size_t i = 0; i < draws; ++i)
+        {
+            source.next(arrival, service);
+            double gap = arrival - previous;
+            previous = arrival;
+
+            sg += gap; ss += service; sgg += gap * gap; sss += service * service; sgs += gap * service;
+            counts[10 * decile(gap, 1.0 / lambda) + decile(service, service_mean)] += 1.0;
+        }
+
+        double n = draws,
+               r = (sgs / n - sg / n * ss / n) / std::sqrt((sgg / n - sg / n * sg / n) * (sss / n - ss / n * ss / n));
+        check(std::fabs(r) <= 5.0 / std::sqrt(n), "gap-service correlation", seed, r, 0.0);
+
+        // chi-square of the 10 x 10 decile table against independent uniform margins
+        // (81 degrees of freedom: mean 81, standard deviation 12.7)
+        double chi2 = 0.0, expected = n / 100.0;
+        for (int c = 0; c < 100; ++c) chi2 += (counts[c] - expected) * (counts[c] - expected) / expected;
+        check(chi2 <= 150.0, "gap-service decile chi-square", seed, chi2, 81.0);
+    }
+
+    void batch(unsigned long seed)
+    {
+        ExponentialBatch b;
+        ExponentialStream plain(0.5, seed, 3),
+                          mirrored(0.5, seed, 3, true);
+        b.setStream(0, 0.5, seed, 3);
+        b.setStream(1, 0.5, seed, 3, true);
+
+        for (int block = 0; block < 100; ++block)
+        {
+            b.refill();
+            for (std::size_t j = 0; j < ExponentialBatch::block; ++j)
+            {
+                double x = plain.next(), y = mirrored.next();
+                check(b.row(j)[0] == x, "batch draw", seed, b.row(j)[0], x);
+                check(b.row(j)[1] == y, "antithetic batch draw", seed, b.row(j)[1], y);
+
+                double u = std::exp(-x / 0.5) + std::exp(-y / 0.5); // U + (1 - U)
+                check(std::fabs(u - 1.0) <= 1e-12, "U + antithetic U", seed, u, 1.0);
+                if (failures > 20) return;
+            }
+        }
+    }
+}
+
+int main()
+{
+    for (int s = 0; s < 3; ++s)
+    {
+        distribution(seeds[s]);
+        independence(seeds[s]);
+        batch(seeds[s]);
+    }
+
+    std::cout << (failures ? "exponential streams: FAILED" : "exponential streams: ok") << std::endl;
+    return failures ? 1 : 0;
+}
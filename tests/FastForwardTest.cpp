@@ -0,0 +1,110 @@
+// Round Robin fast-forward skips slices that cannot change the schedule; it must never
+// change the results. Plain runs match setFastForward(false) for any quantum and load,
+// and so do continuations forked to another quantum. A snapshot holding slices already
+// played at the old quantum refuses to restore at a new one instead of mischarging them.
+//
+// build: cmake -S . -B build && cmake --build build && ctest --test-dir build
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../Simulator.h"
+
+namespace
+{
+    int failures = 0;
+
+    void check(bool ok, const char* what)
+    {
+        if (ok) return;
+
+        std::cout << "FAIL: " << what << std::endl;
+        ++failures;
+    }
+
+    bool same(const SimulationResults& a, const SimulationResults& b)
+    {
+        return a.turnaround_time == b.turnaround_time && a.processes_in_queue == b.processes_in_queue
+            && a.cpu_usage == b.cpu_usage && a.throughput == b.throughput
+            && a.turnaround.p99 == b.turnaround.p99 && a.waiting.p99 == b.waiting.p99
+            && a.mean_queue_length == b.mean_queue_length && a.busy_fraction == b.busy_fraction
+            && a.jobs == b.jobs;
+    }
+
+    void plain(int lambda, double service_time, double quantum, unsigned long seed)
+    {
+        Simulator skipping(4, lambda, service_time, quantum, indexed_heap, seed),
+                  stepping(4, lambda, service_time, quantum, indexed_heap, seed);
+        stepping.setFastForward(false);
+
+        SimulationResults a = skipping.run(),
+                          b = stepping.run();
+        if (same(a, b)) return;
+
+        std::cout << "FAIL lambda " << lambda << " Ts " << service_time << " q " << quantum << " seed " << seed
+                  << ": fast-forward Tq " << a.turnaround_time << " Rho " << a.cpu_usage
+                  << ", per slice Tq " << b.turnaround_time << " Rho " << b.cpu_usage << std::endl;
+        ++failures;
+    }
+
+    // warm up 5004 jobs at q 0.01, then continue at q 0.05 with fast-forward on and off
+    SimulationResults continueAt(Simulator& warm, double quantum, bool fast_forward, bool& forked)
+    {
+        std::vector<double> quanta(1, quantum);
+        std::vector<Simulator*> continuations;
+        std::string error;
+        SimulationResults results;
+
+        forked = warm.fork(quanta, continuations, error);
+        if (forked)
+        {
+            continuations[0]->setFastForward(fast_forward);
+            continuations[0]->resetStatistics();
+            continuations[0]->setJobLimit(5000);
+            results = continuations[0]->run();
+        }
+
+        for (std::size_t i = 0; i < continuations.size(); ++i) delete continuations[i];
+        return results;
+    }
+
+    void forks()
+    {
+        Simulator stepped(4, 10, 0.08, 0.01, indexed_heap, 1),
+                  skipped(4, 10, 0.08, 0.01, indexed_heap, 1);
+        stepped.setFastForward(false);
+        stepped.setJobLimit(5004);
+        stepped.run();
+        skipped.setJobLimit(5004);
+        skipped.run();
+
+        bool forked = false, refused = false;
+        SimulationResults a = continueAt(stepped, 0.05, true, forked);
+        check(forked, "a run without fast-forward forks to another quantum");
+        SimulationResults b = continueAt(stepped, 0.05, false, forked);
+        check(forked && same(a, b), "a fork to another quantum continues the same with and without fast-forward");
+
+        SimulationResults c = continueAt(skipped, 0.05, true, refused);
+        check(!refused || same(a, c), "a fork from a fast-forwarded run never changes the new quantum's results");
+
+        SimulationResults d = continueAt(stepped, 0.01, true, forked),
+                          e = continueAt(skipped, 0.01, true, refused);
+        check(forked && refused && same(d, e), "a fast-forwarded run forks at its own quantum");
+    }
+}
+
+int main()
+{
+    const double quanta[] = { 0.001, 0.01, 0.05, 0.5 };
+
+    for (int q = 0; q < 4; ++q)
+    {
+        plain(10, 0.06, quanta[q], 1);
+        plain(10, 0.08, quanta[q], 2);
+        plain(5, 0.19, quanta[q], 3);
+    }
+    forks();
+
+    std::cout << (failures ? "fast forward: FAILED" : "fast forward: ok") << std::endl;
+    return failures ? 1 : 0;
+}
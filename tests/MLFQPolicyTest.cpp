@@ -0,0 +1,67 @@
+// MLFQ with a single level and no priority boost is Round Robin: on one cpu the two
+// schedulers must give identical metrics, cpu usage included, for any quantum and load.
+// The standard levels double their quantum all the way down to the last level.
+//
+// build: cmake -S . -B build && cmake --build build && ctest --test-dir build
+
+#include <iostream>
+#include "../Simulator.h"
+
+namespace
+{
+    int failures = 0;
+
+    void degenerate(int lambda, double service_time, double quantum, unsigned long seed)
+    {
+        MLFQParameters one_level;
+        one_level.quanta.push_back(quantum);
+        one_level.boost_period = 0;
+
+        Simulator rr(4, lambda, service_time, quantum, indexed_heap, seed),
+                  mlfq(5, lambda, service_time, quantum, indexed_heap, seed, 1, global_queue, NULL, 10000, one_level);
+        SimulationResults a = rr.run(),
+                          b = mlfq.run();
+
+        if (a.turnaround_time == b.turnaround_time && a.processes_in_queue == b.processes_in_queue
+            && a.cpu_usage == b.cpu_usage && a.throughput == b.throughput
+            && a.turnaround.p99 == b.turnaround.p99 && a.waiting.p99 == b.waiting.p99
+            && a.mean_queue_length == b.mean_queue_length && a.busy_fraction == b.busy_fraction) return;
+
+        std::cout << "FAIL lambda " << lambda << " Ts " << service_time << " q " << quantum << " seed " << seed
+                  << ": RR Tq " << a.turnaround_time << " Rho " << a.cpu_usage
+                  << ", MLFQ Tq " << b.turnaround_time << " Rho " << b.cpu_usage << std::endl;
+        ++failures;
+    }
+
+    // every level PriorityArray allows gets twice the quantum of the one above it
+    void standardLevels()
+    {
+        MLFQParameters m = MLFQParameters::standard(0.01, PriorityArray::max_levels);
+
+        for (std::size_t l = 1; l < m.quanta.size(); ++l)
+        {
+            if (m.quanta[l] == 2.0 * m.quanta[l - 1]) continue;
+
+            std::cout << "FAIL level " << l << " quantum " << m.quanta[l] << " after " << m.quanta[l - 1] << std::endl;
+            ++failures;
+            return;
+        }
+    }
+}
+
+int main()
+{
+    standardLevels();
+
+    const double quanta[] = { 0.001, 0.01, 0.05, 0.5 };
+
+    for (int q = 0; q < 4; ++q)
+    {
+        degenerate(10, 0.06, quanta[q], 1);
+        degenerate(10, 0.09, quanta[q], 2);
+        degenerate(20, 0.06, quanta[q], 3);
+    }
+
+    std::cout << (failures ? "mlfq policy: FAILED" : "mlfq policy: ok") << std::endl;
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,59 @@
+// ReplicationRunner: every replication runs the requested number of jobs, through the
+// event loop and through LindleyEngine alike, and a shorter run gives other results
+// than the default 10000 jobs.
+//
+// build: cmake -S . -B build && cmake --build build && ctest --test-dir build
+
+#include <iostream>
+#include <vector>
+#include "../ReplicationRunner.h"
+
+namespace
+{
+    int failures = 0;
+
+    void check(bool ok, const char* what)
+    {
+        if (ok) return;
+
+        std::cout << "FAIL: " << what << std::endl;
+        ++failures;
+    }
+
+    void jobLimit()
+    {
+        std::vector<unsigned long> seeds;
+        for (unsigned long s = 1; s <= 4; ++s) seeds.push_back(s);
+
+        ReplicationRunner runner(1, 10, 0.07, 0.01);
+        ReplicationSummary standard = runner.run(seeds, 2);
+
+        runner.setJobLimit(100);
+        ReplicationSummary shorter = runner.run(seeds, 2);
+
+        runner.setLindley(true);
+        ReplicationSummary lindley = runner.run(seeds, 2);
+
+        for (std::size_t i = 0; i < seeds.size(); ++i)
+        {
+            check(standard.runs[i].jobs == 10000, "the default replication runs 10000 jobs");
+            check(shorter.runs[i].jobs == 100, "setJobLimit(100) runs 100 jobs");
+            check(lindley.runs[i].jobs == 100, "LindleyEngine replications run 100 jobs");
+            check(shorter.runs[i].turnaround_time != standard.runs[i].turnaround_time, "100 jobs differ from 10000");
+            check(lindley.runs[i].turnaround_time == shorter.runs[i].turnaround_time
+                  && lindley.runs[i].processes_in_queue == shorter.runs[i].processes_in_queue
+                  && lindley.runs[i].cpu_usage == shorter.runs[i].cpu_usage
+                  && lindley.runs[i].throughput == shorter.runs[i].throughput, "LindleyEngine matches Simulator at 100 jobs");
+        }
+
+        check(shorter.turnaround_time.mean != standard.turnaround_time.mean, "the summary follows the job limit");
+    }
+}
+
+int main()
+{
+    jobLimit();
+
+    std::cout << (failures ? "replication runner: FAILED" : "replication runner: ok") << std::endl;
+    return failures ? 1 : 0;
+}
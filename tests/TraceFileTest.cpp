@@ -0,0 +1,97 @@
+// Workload traces: a written trace reads back bit-exactly, its header is little-endian
+// whatever the host, and the reader stops at a record whose arrival time goes backwards.
+//
+// build: cmake -S . -B build && cmake --build build && ctest --test-dir build
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdio>      // for remove
+#include "../TraceFile.h"
+#include "../ByteOrder.h"
+
+namespace
+{
+    int failures = 0;
+
+    void check(bool ok, const char* what)
+    {
+        if (ok) return;
+
+        std::cout << "FAIL: " << what << std::endl;
+        ++failures;
+    }
+
+    bool write(const char* path, const double* arrivals, const double* services, int n)
+    {
+        TraceWriter writer;
+        if (!writer.open(path)) return false;
+        for (int i = 0; i < n; ++i) writer.append(arrivals[i], services[i]);
+        return writer.close();
+    }
+
+    void roundTrip()
+    {
+        const char* path = "trace_file_test.trace";
+        const double arrivals[] = { 0.0, 0.25, 0.25, 1.0 / 3.0 },
+                     services[] = { 0.1, 0.0, 1e-300, 7.5 };
+
+        check(write(path, arrivals, services, 4), "trace written");
+
+        std::ifstream in(path, std::ios::binary);
+        unsigned char header[24];
+        in.read(reinterpret_cast<char*>(header), sizeof(header));
+        check(header[8] == 1 && header[9] == 0 && header[12] == 16 && header[16] == 4 && header[17] == 0,
+              "header fields are little-endian");
+
+        TraceReader reader;
+        check(reader.open(path), "trace opened");
+        check(reader.records() == 4, "record count");
+
+        double a, s;
+        for (int i = 0; i < 4; ++i)
+        {
+            check(reader.next(a, s), "record read");
+            check(a == arrivals[i] && s == services[i], "record read back bit-exactly");
+        }
+        check(!reader.next(a, s) && reader.error().empty(), "clean end of trace");
+
+        std::remove(path);
+    }
+
+    void backwards()
+    {
+        const char* path = "trace_file_test_backwards.trace";
+        const double arrivals[] = { 0.0, 1.0, 2.0, 3.0 },
+                     services[] = { 0.5, 0.5, 0.5, 0.5 };
+
+        check(write(path, arrivals, services, 4), "trace written");
+
+        // move record 2 before record 1 behind the writer's back
+        std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+        double early = ByteOrder::littleEndian(0.5);
+        f.seekp(24 + 2 * 16);
+        f.write(reinterpret_cast<const char*>(&early), sizeof(early));
+        f.close();
+
+        TraceReader reader;
+        check(reader.open(path), "trace opened");
+
+        double a, s;
+        check(reader.next(a, s) && reader.next(a, s), "records before the bad one read");
+        check(!reader.next(a, s), "arrival going backwards rejected");
+        check(reader.error().find("record 2") != std::string::npos, "error names the record");
+        check(!reader.next(a, s), "no records after the bad one");
+
+        std::remove(path);
+    }
+}
+
+int main()
+{
+    roundTrip();
+    backwards();
+
+    std::cout << (failures ? "trace file: FAILED" : "trace file: ok") << std::endl;
+    return failures ? 1 : 0;
+}